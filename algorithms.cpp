@@ -13,165 +13,569 @@
  */
 #include "Pallet.h"
 #include "algorithms.h"
+#include "objective.h"
+#include "efficiency.h"
+#include "solver_templates.h"
+#include "dispatch.h"
+#include "dp_storage.h"
+#include "spill.h"
+#include "workspace.h"
 #include <vector>
 #include <algorithm>
 #include <iostream>
 #include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
 
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 //case 1
 
+namespace {
+    /**
+     * @brief Tie-break between two loads with the same packed key.
+     *
+     * Prefers the load that leaves out the last pallet (in input order) on
+     * which the two differ. KDynamic's reconstruction makes the same choice,
+     * so every exact solver returns the same selection on tied instances.
+     *
+     * @param candidate New load, one bit per input index.
+     * @param incumbent Current best load, same size.
+     * @return true if the candidate should replace the incumbent.
+     */
+    bool preferOnTie(const TrailBits& candidate, const TrailBits& incumbent) {
+        // A palete de maior índice onde diferem decide: fica a carga que a deixa de fora
+        for (size_t k = candidate.count; k-- > 0;) {
+            uint64_t differ = candidate.words[k] ^ incumbent.words[k];
+            if (differ) return (incumbent.words[k] & (uint64_t(1) << (63 - __builtin_clzll(differ)))) != 0;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Lists the input indices set in a trail selection.
+     *
+     * @param bits Selection, one bit per input index.
+     * @param n Number of pallets.
+     * @param indices Output input indices, ascending (storage reused).
+     */
+    void trailIndices(const TrailBits& bits, int n, std::vector<int>& indices) {
+        indices.clear();
+        for (int i = 0; i < n; ++i) {
+            if (bits.test(i)) indices.push_back(i);
+        }
+    }
+
+    /**
+     * @brief Fills an ILPResult from input indices.
+     *
+     * The result's selection is cleared and refilled, so its storage is reused.
+     *
+     * @param pallets List of pallets.
+     * @param indices Input indices of the selected pallets, ascending.
+     * @param profit Total profit of the selection.
+     * @param result Result to fill, with IDs in input order.
+     */
+    void writeResult(const std::vector<Pallet>& pallets, const std::vector<int>& indices, long long profit,
+                     ILPResult& result) {
+        result.totalProfit = profit;
+        result.totalWeight = 0;
+        result.selectedPallets.clear();
+        for (int i : indices) {
+            result.selectedPallets.push_back(pallets[i].getID());
+            result.totalWeight += pallets[i].getWeight();
+        }
+    }
+
+    /**
+     * @brief Prints the selected pallets as the K* wrappers do.
+     *
+     * @param result Solution to print.
+     * @param pallets List of pallets.
+     */
+    void printSelection(const ILPResult& result, const std::vector<Pallet>& pallets) {
+        std::cout << "Selected Pallets (ID | Value | Weight):\n";
+        for (int id : result.selectedPallets) {
+            auto it = std::find_if(pallets.begin(), pallets.end(), [id](const Pallet& p) {
+                return p.id == id;
+            });
+            if (it != pallets.end()) {
+                std::cout << it->id << " | " << it->profit << " | " << it->weight << "\n";
+            }
+        }
+    }
+}
+
 /**
  * @brief Recursive brute-force solution to the 0/1 Knapsack Problem.
  *
  * Tries all combinations of including/excluding each pallet.
- * Optimizes for maximum profit and minimal pallet usage.
+ * Optimizes the packed objective: maximum profit, then fewest pallets,
+ * then lowest weight.
  *
  * @param pallets Vector of pallets.
+ * @param objective Packed key layout of the instance.
  * @param index Current index of recursion.
  * @param remainingCapacity Remaining capacity of the truck.
- * @param currentProfit Accumulated profit.
- * @param currentSubset Current pallet IDs being considered.
- * @param bestProfit Reference to best profit found.
- * @param bestSubset Reference to best subset found.
- * @return Best profit found.
+ * @param currentKey Packed key of the current subset.
+ * @param currentSubset Current subset, one bit per input index (a trail in the workspace arena).
+ * @param bestKey Reference to best key found.
+ * @param bestSubset Best subset found, same layout; overwritten word by word on improvement.
+ * @return Best key found.
  */
 
-int knapsackRecursive(const std::vector<Pallet>& pallets, int index, int remainingCapacity,
-                      int currentProfit, std::vector<int>& currentSubset,
-                      int& bestProfit, std::vector<int>& bestSubset) {
+template <typename Key>
+Key knapsackRecursive(const std::vector<Pallet>& pallets, const ObjectiveKey<Key>& objective,
+                      int index, int remainingCapacity,
+                      Key currentKey, TrailBits currentSubset,
+                      Key& bestKey, TrailBits bestSubset) {
 
-    if (index == pallets.size()) {
-        if (currentProfit > bestProfit ||
-            (currentProfit == bestProfit && currentSubset.size() < bestSubset.size())) {
-            bestProfit = currentProfit;
-            bestSubset = currentSubset;
+    if (index == static_cast<int>(pallets.size())) {
+        if (currentKey > bestKey ||
+            (currentKey == bestKey && preferOnTie(currentSubset, bestSubset))) {
+            bestKey = currentKey;
+            bestSubset.assign(currentSubset);
         }
-        return bestProfit;
+        return bestKey;
     }
 
-    knapsackRecursive(pallets, index + 1, remainingCapacity,
-                      currentProfit, currentSubset, bestProfit, bestSubset);
+    knapsackRecursive(pallets, objective, index + 1, remainingCapacity,
+                      currentKey, currentSubset, bestKey, bestSubset);
 
     if (pallets[index].weight <= remainingCapacity) {
-        currentSubset.push_back(pallets[index].id);
-        knapsackRecursive(pallets, index + 1, remainingCapacity - pallets[index].weight,
-                          currentProfit + pallets[index].profit, currentSubset, bestProfit, bestSubset);
-        currentSubset.pop_back();
+        currentSubset.set(index);
+        knapsackRecursive(pallets, objective, index + 1, remainingCapacity - pallets[index].weight,
+                          currentKey + objective.itemKey(pallets[index]), currentSubset, bestKey, bestSubset);
+        currentSubset.reset(index);
     }
 
-    return bestProfit;
+    return bestKey;
+}
+
+namespace {
+    template <typename Key>
+    void bruteForceWith(const std::vector<Pallet>& pallets, int capacity, SolverWorkspace& workspace,
+                        ILPResult& result) {
+        ObjectiveKey<Key> objective = ObjectiveKey<Key>::forInstance(pallets, capacity);
+        Key bestKey = -1;
+        int n = pallets.size();
+
+        // Seleção atual e incumbente vivem na arena do workspace, libertada no fim
+        workspace.trail.begin(2 * TrailArena::wordsFor(n));
+        TrailBits current = workspace.trail.take(n);
+        TrailBits best = workspace.trail.take(n);
+
+        knapsackRecursive<Key>(pallets, objective, 0, capacity, objective.emptyKey(),
+                               current, bestKey, best);
+
+        trailIndices(best, n, workspace.best);
+        workspace.trail.release();
+        writeResult(pallets, workspace.best, objective.profit(bestKey), result);
+    }
 }
 
 /**
- * @brief Wrapper for brute-force recursive knapsack solver.
+ * @brief Solves the knapsack problem by brute force without printing.
  *
- * Initializes tracking variables and prints selected pallet IDs.
+ * Instances with up to 16 pallets go to the Gray-code enumeration of
+ * solver_templates.h; larger ones run the recursion with the narrowest key
+ * type that fits the instance (see chooseKeyWidth()). Both visit every
+ * subset: the pruned searches belong to solveILP().
  *
- * @param capacity Max truck capacity.
  * @param pallets List of available pallets.
- * @return Maximum achievable profit.
+ * @param capacity Max truck capacity.
+ * @return ILPResult containing selected pallets, total weight, and profit.
  */
-int KBruteForce(int capacity, const std::vector<Pallet>& pallets) {
-    int bestProfit = 0;
-    std::vector<int> bestSubset;
-    std::vector<int> currentSubset;
-
-    int finalProfit = knapsackRecursive(pallets, 0, capacity, 0, currentSubset, bestProfit, bestSubset);
+void solveBruteForce(const std::vector<Pallet>& pallets, int capacity, SolverWorkspace& workspace,
+                     ILPResult& result) {
+    // Até 16 paletes: enumeração em código de Gray sem alocações (solver_templates.h)
+    if (tryEnumerateSmall(pallets, capacity, result)) return;
 
-    std::cout << "Selected Pallets (ID | Value | Weight):\n";
-    for (int id : bestSubset) {
-        auto it = std::find_if(pallets.begin(), pallets.end(), [id](const Pallet& p) {
-            return p.id == id;
-        });
-        if (it != pallets.end()) {
-            std::cout << it->id << " | " << it->profit << " | " << it->weight << "\n";
-        }
+    switch (chooseKeyWidth(pallets, capacity)) {
+        case KeyWidth::Bits32: bruteForceWith<int32_t>(pallets, capacity, workspace, result); break;
+        case KeyWidth::Bits64: bruteForceWith<int64_t>(pallets, capacity, workspace, result); break;
+        default: bruteForceWith<__int128>(pallets, capacity, workspace, result); break;
     }
-
-
-    return finalProfit;
 }
 
-//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
-
-//case 2
+/**
+ * @brief Runs solveBruteForce() on a workspace of its own.
+ */
+ILPResult solveBruteForce(const std::vector<Pallet>& pallets, int capacity) {
+    SolverWorkspace workspace;
+    ILPResult result;
+    solveBruteForce(pallets, capacity, workspace, result);
+    return result;
+}
 
 /**
- * @brief Dynamic programming solution to the 0/1 Knapsack Problem.
+ * @brief Wrapper for brute-force recursive knapsack solver.
  *
- * Builds a DP table to compute optimal profit with subproblem reuse.
- * Also tracks the minimal number of pallets used to resolve ties.
+ * Runs solveBruteForce() and prints selected pallet IDs.
  *
  * @param capacity Max truck capacity.
  * @param pallets List of available pallets.
  * @return Maximum achievable profit.
  */
-int KDynamic(int capacity, const std::vector<Pallet>& pallets) {
-    int n = pallets.size();
+long long KBruteForce(int capacity, const std::vector<Pallet>& pallets, SolverWorkspace& workspace) {
+    solveBruteForce(pallets, capacity, workspace, workspace.result);
+    printSelection(workspace.result, pallets);
+
+    return workspace.result.totalProfit;
+}
+
+/**
+ * @brief Runs KBruteForce() on a workspace of its own.
+ */
+long long KBruteForce(int capacity, const std::vector<Pallet>& pallets) {
+    SolverWorkspace workspace;
+    return KBruteForce(capacity, pallets, workspace);
+}
+
+//------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
+
+//case 2
 
-    // Tabela de lucro máximo
-    std::vector<std::vector<int>> dp(n + 1, std::vector<int>(capacity + 1, 0));
+namespace {
+    thread_local DpSweepReport lastSweep{0, 0};
+
+    /**
+     * @brief Segment of a DP row: out[j] = max(stay[j], shifted[j] + chave).
+     *
+     * 32- and 64-bit keys use the dispatched kernels; 128-bit keys this loop.
+     */
+    template <typename Key>
+    void relaxSegment(const Key* stay, const Key* shifted, Key* out, int count, Key chave) {
+        for (int j = 0; j < count; ++j) out[j] = std::max(stay[j], shifted[j] + chave);
+    }
+
+    void relaxSegment(const int32_t* stay, const int32_t* shifted, int32_t* out, int count, int32_t chave) {
+        dpKernels().relaxSegment32(stay, shifted, out, count, chave);
+    }
+
+    void relaxSegment(const int64_t* stay, const int64_t* shifted, int64_t* out, int count, int64_t chave) {
+        dpKernels().relaxSegment64(stay, shifted, out, count, chave);
+    }
+
+    /**
+     * @brief Full-table DP that only fills the live columns of each row.
+     *
+     * Row i (pallets 0..i-1) is constant beyond the prefix weight sum S_i,
+     * and later rows and the reconstruction never read it below
+     * C - R_i, where R_i is the weight of pallets i..n-1. Each row is
+     * therefore filled on [min(C - R_i, hi_i), hi_i] with hi_i = min(C, S_i),
+     * and reads beyond hi_i are clamped to hi_i. Before relaxing row i, the
+     * previous row is extended over (hi_{i-1}, hi_i] with its last value, so
+     * the vector kernels see plain arrays. Pallets keep their input order,
+     * since the tie rule depends on it.
+     */
+    template <typename Key>
+    void dynamicWith(const std::vector<Pallet>& pallets, int capacity, SolverWorkspace& workspace,
+                     ILPResult& result, DpMemoryReport* memory) {
+        int n = pallets.size();
+        ObjectiveKey<Key> objective = ObjectiveKey<Key>::forInstance(pallets, capacity);
 
-    // Tabela auxiliar: número mínimo de paletes usadas para obter aquele lucro
-    std::vector<std::vector<int>> count(n + 1, std::vector<int>(capacity + 1, 0));
+        long long remaining = 0;
+        for (const Pallet& p : pallets) remaining += p.weight;
 
-    // Preenchimento da tabela
-    for (int i = 1; i <= n; ++i) {
-        for (int w = 0; w <= capacity; ++w) {
+        // Tabela de chaves (lucro, -paletes, -peso) compactadas num inteiro, no bloco alinhado do
+        // workspace; cada linha só é escrita na sua janela viva [lo, hi]
+        DpRows<Key> dp = workspace.table<Key>(n + 1, capacity + 1);
+        dp(0, 0) = objective.emptyKey();
+        long long touched = 1;
+
+        long long prefix = 0;
+        int prevHi = 0;
+        for (int i = 1; i <= n; ++i) {
             int peso = pallets[i - 1].weight;
-            int lucro = pallets[i - 1].profit;
-
-            if (peso <= w) {
-                int inclui = lucro + dp[i - 1][w - peso];
-                int exclui = dp[i - 1][w];
-
-                if (inclui > exclui) {
-                    dp[i][w] = inclui;
-                    count[i][w] = count[i - 1][w - peso] + 1;
-                } else if (inclui < exclui) {
-                    dp[i][w] = exclui;
-                    count[i][w] = count[i - 1][w];
-                } else {
-                    // Empate de lucro: escolher o que usar menos paletes
-                    int incluiCount = count[i - 1][w - peso] + 1;
-                    int excluiCount = count[i - 1][w];
-                    dp[i][w] = inclui;
-                    count[i][w] = std::min(incluiCount, excluiCount);
-                }
-            } else {
-                dp[i][w] = dp[i - 1][w];
-                count[i][w] = count[i - 1][w];
+            Key chave = objective.itemKey(pallets[i - 1]);
+            prefix += peso;
+            remaining -= peso;
+            int hi = static_cast<int>(std::min<long long>(capacity, prefix));
+            int lo = static_cast<int>(std::min<long long>(std::max<long long>(capacity - remaining, 0), hi));
+
+            // Para lá de prevHi a linha anterior é constante: estendê-la até hi
+            Key* prev = dp.row(i - 1);
+            Key* curr = dp.row(i);
+            if (hi > prevHi) {
+                std::fill(prev + prevHi + 1, prev + hi + 1, prev[prevHi]);
+                touched += hi - prevHi;
             }
+
+            int start = std::max(lo, std::min(peso, hi + 1));
+            std::copy(prev + lo, prev + start, curr + lo);
+            if (start <= hi) relaxSegment(prev + start, prev + start - peso, curr + start, hi + 1 - start, chave);
+            touched += hi + 1 - lo;
+            prevHi = hi;
         }
+        lastSweep = DpSweepReport{touched, (static_cast<long long>(n) + 1) * (capacity + 1)};
+        if (memory) {
+            *memory = workspace.tableReport(static_cast<size_t>(n + 1) * ((static_cast<size_t>(capacity) + 1) *
+                                                                          sizeof(Key) + 63) / 64 * 64);
+        }
+        Key bestKey = dp(n, prevHi);
+
+        // Reconstruir subconjunto ótimo (em empate exato, excluir a palete); hi da linha i-1 é min(C, S_{i-1})
+        std::vector<int>& indices = workspace.best;
+        indices.clear();
+        int w = capacity;
+        for (int i = n; i > 0; --i) {
+            int peso = pallets[i - 1].weight;
+            int hi = static_cast<int>(std::min<long long>(capacity, prefix));
+            prefix -= peso;
+            int below = static_cast<int>(std::min<long long>(capacity, prefix));
+            if (dp(i, std::min(w, hi)) != dp(i - 1, std::min(w, below))) {
+                indices.push_back(i - 1);
+                w -= peso;
+            }
+        }
+
+        std::reverse(indices.begin(), indices.end());
+        writeResult(pallets, indices, objective.profit(bestKey), result);
     }
 
-    // Reconstruir subconjunto ótimo (preferência por menos paletes)
-    int w = capacity;
-    std::vector<int> selectedIDs;
+    // Acima disto uma linha já não cabe numa cache L2 típica
+    constexpr size_t TILE_MIN_ROW_BYTES = size_t(1) << 20;
+    // Orçamento das janelas de uma banda, para ficarem na L2
+    constexpr size_t TILE_BUDGET_BYTES = size_t(1) << 18;
+    // Paletes por banda
+    constexpr int TILE_BAND = 8;
 
-    for (int i = n; i > 0 && w > 0; --i) {
-        if (dp[i][w] != dp[i - 1][w]) {
-            selectedIDs.push_back(pallets[i - 1].id);
-            w -= pallets[i - 1].weight;
+    /**
+     * @brief Bit b set when curr[b] != prev[b], for up to 64 cells.
+     *
+     * The comparisons go to a byte array (a full block of 64 has a constant
+     * trip count and vectorizes) and every 8 bytes of 0/1 are gathered into
+     * 8 bits with one multiplication (little-endian byte order).
+     */
+    template <typename Key>
+    uint64_t changedMask(const Key* prev, const Key* curr, int count) {
+        uint8_t changed[64] = {};
+        if (count == 64) {
+            for (int b = 0; b < 64; ++b) changed[b] = curr[b] != prev[b];
+        } else {
+            for (int b = 0; b < count; ++b) changed[b] = curr[b] != prev[b];
         }
+
+        uint64_t mask = 0;
+        for (int byte = 0; byte < 8; ++byte) {
+            uint64_t eight;
+            std::memcpy(&eight, changed + 8 * byte, 8);
+            mask |= ((eight * 0x0102040810204080ULL) >> 56) << (8 * byte);
+        }
+        return mask;
     }
 
-    std::reverse(selectedIDs.begin(), selectedIDs.end());
+    /**
+     * @brief Cache-blocked version of dynamicWith() for rows larger than L2.
+     *
+     * Pallets are taken in bands of up to TILE_BAND consecutive pallets. A
+     * band sweeps the capacity in tiles and applies all of its pallets to a
+     * tile before moving to the next one, so each tile stays in cache across
+     * the whole band. Row k of a band at tile [lo, hi) reads row k-1 at
+     * [lo - weight, hi), so the intermediate rows are kept as windows
+     * [lo - halo, hi), where the halo is the largest weight in the band. After
+     * each tile the last halo cells slide to the front of the window. A pallet
+     * heavier than the halo limit gets a band of its own, which is a plain
+     * row pass.
+     *
+     * Only the band's input and output rows span the whole capacity. The
+     * table is replaced by one decision bit per cell (set when the pallet
+     * strictly improves the cell), so the reconstruction and the tie rule
+     * are the same as in dynamicWith(). Decision bits larger than
+     * spillThresholdBytes() go to a scratch file (spill.h), one band at a
+     * time.
+     */
+    template <typename Key>
+    void dynamicTiledWith(const std::vector<Pallet>& pallets, int capacity, SolverWorkspace& workspace,
+                          ILPResult& result, DpMemoryReport* memory) {
+        int n = pallets.size();
+        ObjectiveKey<Key> objective = ObjectiveKey<Key>::forInstance(pallets, capacity);
+        const int columns = capacity + 1;
+        const size_t words = (static_cast<size_t>(columns) + 63) / 64;
+        const int haloLimit = static_cast<int>(TILE_BUDGET_BYTES / (sizeof(Key) * (TILE_BAND + 1)) / 2);
 
-    std::cout << "Selected Pallets (ID | Value | Weight):\n";
-    for (int id : selectedIDs) {
-        auto it = std::find_if(pallets.begin(), pallets.end(), [id](const Pallet& p) {
-            return p.id == id;
-        });
-        if (it != pallets.end()) {
-            std::cout << it->id << " | " << it->profit << " | " << it->weight << "\n";
+        DecisionRows decisions(n, words, TILE_BAND);
+        DpMatrix<Key> input(1, columns);
+        DpMatrix<Key> output(1, columns);
+        std::fill(input.row(0), input.row(0) + columns, objective.emptyKey());
+        std::vector<std::vector<Key>> windows(TILE_BAND - 1);
+
+        for (int first = 0; first < n;) {
+            // Formar a banda: paletes seguidas com peso até ao limite do halo
+            int halo = std::min(pallets[first].weight, columns);
+            int last = first + 1;
+            if (halo <= haloLimit) {
+                while (last < n && last - first < TILE_BAND && std::min(pallets[last].weight, columns) <= haloLimit) {
+                    halo = std::max(halo, std::min(pallets[last].weight, columns));
+                    ++last;
+                }
+            }
+            int band = last - first;
+            int tile = band == 1 ? columns
+                                 : std::max<int>(haloLimit, TILE_BUDGET_BYTES / (sizeof(Key) * (band + 1)) - halo);
+            tile = (tile + 63) / 64 * 64;
+            for (int k = 0; k + 1 < band; ++k) windows[k].assign(static_cast<size_t>(halo) + tile, Key(0));
+
+            for (int lo = 0; lo < columns; lo += tile) {
+                int count = std::min(tile, columns - lo);
+
+                for (int k = 0; k < band; ++k) {
+                    const Pallet& p = pallets[first + k];
+                    int peso = std::min(p.weight, columns);
+
+                    // prev[j] / curr[j] são as células lo + j da linha anterior / atual
+                    const Key* prev = k == 0 ? input.row(0) + lo : windows[k - 1].data() + halo;
+                    Key* curr = k == band - 1 ? output.row(0) + lo : windows[k].data() + halo;
+
+                    int start = std::min(std::max(peso - lo, 0), count);
+                    std::copy(prev, prev + start, curr);
+                    relaxSegment(prev + start, prev + start - peso, curr + start, count - start,
+                                 objective.itemKey(p));
+
+                    // lo é múltiplo de 64 e antes de start curr == prev, logo palavras inteiras
+                    uint64_t* bits = decisions.bandRow(first, k) + lo / 64;
+                    for (int j = 0; j < count; j += 64) {
+                        bits[j / 64] = changedMask(prev + j, curr + j, std::min(64, count - j));
+                    }
+                }
+
+                // Deslizar as janelas: as últimas "halo" células passam para o início
+                for (int k = 0; k + 1 < band; ++k) {
+                    std::copy(windows[k].begin() + count, windows[k].begin() + count + halo, windows[k].begin());
+                }
+            }
+
+            if (!decisions.commitBand(first, band)) {
+                throw std::runtime_error("could not write DP decisions to the scratch file");
+            }
+            std::swap(input, output);
+            first = last;
+        }
+        if (!decisions.finish()) throw std::runtime_error("could not map the DP scratch file");
+        lastSweep = DpSweepReport{static_cast<long long>(n) * columns, static_cast<long long>(n) * columns};
+        if (memory) *memory = decisions.memoryReport();
+
+        // Reconstruir subconjunto ótimo (em empate exato, excluir a palete)
+        std::vector<int>& indices = workspace.best;
+        indices.clear();
+        int w = capacity;
+        for (int i = n - 1; i >= 0; --i) {
+            if (decisions.taken(i, w)) {
+                indices.push_back(i);
+                w -= pallets[i].weight;
+            }
         }
+
+        std::reverse(indices.begin(), indices.end());
+        writeResult(pallets, indices, objective.profit(input(0, capacity)), result);
+    }
+
+    /**
+     * @brief Picks the full-table or the cache-blocked DP by row and table size.
+     */
+    template <typename Key>
+    void dynamicFor(const std::vector<Pallet>& pallets, int capacity, SolverWorkspace& workspace,
+                    ILPResult& result, DpMemoryReport* memory) {
+        size_t rowBytes = (static_cast<size_t>(capacity) + 1) * sizeof(Key);
+        if (rowBytes > TILE_MIN_ROW_BYTES || (pallets.size() + 1) * rowBytes > spillThresholdBytes()) {
+            dynamicTiledWith<Key>(pallets, capacity, workspace, result, memory);
+        } else {
+            dynamicWith<Key>(pallets, capacity, workspace, result, memory);
+        }
+    }
+}
+
+/**
+ * @brief Returns the cells touched by the last DP of this thread.
+ *
+ * @return Report set by solveDynamic().
+ */
+DpSweepReport lastDpSweepReport() {
+    return lastSweep;
+}
+
+/**
+ * @brief Dynamic programming solution to the 0/1 Knapsack Problem.
+ *
+ * Builds a DP table of packed objective keys (profit, then fewest pallets,
+ * then lowest weight), so each cell is a single max of two integers and
+ * ties are resolved inside the key instead of in a second table. The key
+ * type is the narrowest of 32, 64 and 128 bits that fits the instance.
+ * Up to 16 pallets, when 2^n subsets are fewer than the table cells, the
+ * Gray-code enumeration of solver_templates.h is used instead. Each row is
+ * only filled on its live column window (see lastDpSweepReport()). When a
+ * row no longer fits in L2, a cache-blocked pass with one decision bit per
+ * cell replaces the table.
+ *
+ * @param pallets List of available pallets.
+ * @param capacity Max truck capacity.
+ * @return ILPResult containing selected pallets, total weight, and profit.
+ */
+void solveDynamic(const std::vector<Pallet>& pallets, int capacity, SolverWorkspace& workspace,
+                  ILPResult& result, DpMemoryReport* memory) {
+    // Poucas paletes e capacidade grande: enumerar 2^n subconjuntos é mais barato que n*C células
+    int n = pallets.size();
+    lastSweep = DpSweepReport{0, 0};
+    if (memory) *memory = DpMemoryReport{0, false, 0};
+    if (n <= SMALL_PALLETS && (1LL << n) <= static_cast<long long>(n) * (capacity + 1) &&
+        tryEnumerateSmall(pallets, capacity, result)) {
+        return;
     }
 
-    return dp[n][capacity];
+    switch (chooseKeyWidth(pallets, capacity)) {
+        case KeyWidth::Bits32: dynamicFor<int32_t>(pallets, capacity, workspace, result, memory); break;
+        case KeyWidth::Bits64: dynamicFor<int64_t>(pallets, capacity, workspace, result, memory); break;
+        default: dynamicFor<__int128>(pallets, capacity, workspace, result, memory); break;
+    }
+}
+
+/**
+ * @brief Runs solveDynamic() on a workspace of its own.
+ */
+ILPResult solveDynamic(const std::vector<Pallet>& pallets, int capacity) {
+    SolverWorkspace workspace;
+    ILPResult result;
+    solveDynamic(pallets, capacity, workspace, result);
+    return result;
+}
+
+/**
+ * @brief Runs solveDynamic() on a workspace of its own and reports its table.
+ */
+ILPResult solveDynamic(const std::vector<Pallet>& pallets, int capacity, DpMemoryReport& memory) {
+    SolverWorkspace workspace;
+    ILPResult result;
+    solveDynamic(pallets, capacity, workspace, result, &memory);
+    return result;
+}
+
+/**
+ * @brief Dynamic programming solution to the 0/1 Knapsack Problem.
+ *
+ * Runs solveDynamic() and prints the selected pallets.
+ *
+ * @param capacity Max truck capacity.
+ * @param pallets List of available pallets.
+ * @return Maximum achievable profit.
+ */
+long long KDynamic(int capacity, const std::vector<Pallet>& pallets, SolverWorkspace& workspace) {
+    solveDynamic(pallets, capacity, workspace, workspace.result);
+    printSelection(workspace.result, pallets);
+
+    return workspace.result.totalProfit;
+}
+
+/**
+ * @brief Runs KDynamic() on a workspace of its own.
+ */
+long long KDynamic(int capacity, const std::vector<Pallet>& pallets) {
+    SolverWorkspace workspace;
+    return KDynamic(capacity, pallets, workspace);
 }
 
 
@@ -183,28 +587,26 @@ int KDynamic(int capacity, const std::vector<Pallet>& pallets) {
 /**
  * @brief Greedy approximation solution to the 0/1 Knapsack Problem.
  *
- * Sorts pallets by profit-to-weight ratio and selects greedily.
- * Does not guarantee optimality but is fast for large instances.
+ * Visits pallets in efficiencyOrder() (ties by input order, pallets
+ * without weight first) and selects greedily. Does not guarantee
+ * optimality but is fast for large instances.
  *
  * @param capacity Max truck capacity.
  * @param pallets List of available pallets.
  * @return Approximate total profit.
  */
-int KProxy(int capacity, const std::vector<Pallet>& pallets) {
-    std::vector<Pallet> sorted = pallets;
-
-    // Ordenar por eficiência decrescente (lucro/peso)
-    std::sort(sorted.begin(), sorted.end(), [](const Pallet& a, const Pallet& b) {
-        double r1 = static_cast<double>(a.profit) / a.weight;
-        double r2 = static_cast<double>(b.profit) / b.weight;
-        return r1 > r2;
-    });
+long long KProxy(int capacity, const std::vector<Pallet>& pallets, SolverWorkspace& workspace) {
+    // Eficiência decrescente (efficiency.h), a mesma ordem dos limites dos solvers exatos
+    std::vector<int>& order = workspace.order;
+    efficiencyOrder(pallets, order);
 
-    int totalProfit = 0;
-    int totalWeight = 0;
-    std::vector<int> selectedIDs;
+    long long totalProfit = 0;
+    long long totalWeight = 0;
+    std::vector<int>& selectedIDs = workspace.ids;
+    selectedIDs.clear();
 
-    for (const auto& p : sorted) {
+    for (int i : order) {
+        const Pallet& p = pallets[i];
         if (totalWeight + p.weight <= capacity) {
             selectedIDs.push_back(p.id);
             totalWeight += p.weight;
@@ -228,64 +630,344 @@ int KProxy(int capacity, const std::vector<Pallet>& pallets) {
     return totalProfit;
 }
 
+/**
+ * @brief Runs KProxy() on a workspace of its own.
+ */
+long long KProxy(int capacity, const std::vector<Pallet>& pallets) {
+    SolverWorkspace workspace;
+    return KProxy(capacity, pallets, workspace);
+}
+
 
 //------------------------------------------------------------------------------------------------------------------------------------------------------------------------------------
 
 //case 4
 
 
+namespace {
+    thread_local long long searchNodes = 0;
+
+    /**
+     * @brief LP bound of the B&B (efficiency.h) plus the largest profit of every suffix.
+     */
+    struct SearchBounds {
+        LPBound lp;
+        std::vector<long long>& suffixMax;
+
+        /**
+         * @brief Builds the prefix sums and suffix maxima in the workspace's vectors.
+         * @param sorted Pallets sorted by decreasing profit/weight ratio.
+         * @param workspace Owner of the vectors.
+         */
+        SearchBounds(const std::vector<Pallet>& sorted, SolverWorkspace& workspace)
+            : lp(sorted, workspace.prefWeight, workspace.prefProfit), suffixMax(workspace.suffixMax) {
+            suffixMax.assign(sorted.size() + 1, 0);
+            for (size_t i = sorted.size(); i-- > 0;) {
+                suffixMax[i] = std::max<long long>(suffixMax[i + 1], sorted[i].getProfit());
+            }
+        }
+
+        /**
+         * @brief Fewest pallets among idx..n-1 that can add a given profit.
+         *
+         * @param idx First pallet still undecided.
+         * @param missing Profit still missing (> 0).
+         * @return Lower bound on the pallets needed, n + 1 if none has profit.
+         */
+        long long minPallets(int idx, long long missing) const {
+            if (suffixMax[idx] <= 0) return static_cast<long long>(suffixMax.size());
+            return (missing + suffixMax[idx] - 1) / suffixMax[idx];
+        }
+    };
+
+    /**
+     * @brief Turns a previous selection into a feasible one for the current pallets.
+     *
+     * IDs that no longer exist are dropped, the least efficient pallets are
+     * removed while the truck is overloaded, and the remaining pallets are
+     * then added greedily while they fit.
+     *
+     * @param sorted Pallets sorted by decreasing profit/weight ratio.
+     * @param capacity Truck capacity.
+     * @param selection Previously selected pallet IDs.
+     * @param ids Scratch vector for the sorted IDs.
+     * @param inSelection Output flags, one per sorted pallet.
+     */
+    void repairSelection(const std::vector<Pallet>& sorted, int capacity,
+                         const std::vector<int>& selection, std::vector<int>& ids, std::vector<char>& inSelection) {
+        ids.assign(selection.begin(), selection.end());
+        std::sort(ids.begin(), ids.end());
+
+        inSelection.assign(sorted.size(), 0);
+        long long weight = 0;
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            if (std::binary_search(ids.begin(), ids.end(), sorted[i].getID())) {
+                inSelection[i] = 1;
+                weight += sorted[i].getWeight();
+            }
+        }
+
+        for (int i = static_cast<int>(sorted.size()) - 1; i >= 0 && weight > capacity; --i) {
+            if (inSelection[i]) {
+                inSelection[i] = 0;
+                weight -= sorted[i].getWeight();
+            }
+        }
+
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            if (!inSelection[i] && weight + sorted[i].getWeight() <= capacity) {
+                inSelection[i] = 1;
+                weight += sorted[i].getWeight();
+            }
+        }
+    }
+}
+
+namespace {
+    // Orçamento da tabela das paletes finais do B&B híbrido
+    constexpr size_t HYBRID_TAIL_BYTES = size_t(1) << 22;
+
+    // Paletes finais resolvidas pela DP: no máximo estas, e nunca mais de metade
+    constexpr int HYBRID_TAIL_PALLETS = 16;
+
+    /**
+     * @brief Exact DP over the last pallets of the efficiency order.
+     *
+     * dp(j, c) is the best key delta (base 0) of the first j tail pallets,
+     * taken by input index, with capacity c. Once the B&B has decided every
+     * pallet before depth, dp(count, remaining) is the best completion, and
+     * the reconstruction below (exclude on ties, same rule as KDynamic())
+     * gives the preferred one among equal completions.
+     */
+    template <typename Key>
+    struct TailTable {
+        int depth;                          // profundidade a partir da qual a DP completa a carga
+        int count;                          // paletes finais (0 = sem tabela)
+        DpRows<Key> dp;
+        const std::vector<int>& items;      // índices originais das paletes finais, crescentes
+        const std::vector<Pallet>& input;   // paletes pela ordem original
+    };
+
+    /**
+     * @brief Builds the tail DP for the last pallets of the efficiency order.
+     *
+     * At most HYBRID_TAIL_PALLETS pallets, and at most half of them, so the
+     * B&B still searches the head of the order; fewer when the table would
+     * not fit in HYBRID_TAIL_BYTES.
+     *
+     * @param input Pallets in input order.
+     * @param order Input index of each pallet in efficiency order.
+     * @param capacity Truck capacity.
+     * @param objective Packed key layout of the instance.
+     * @param workspace Owner of the table and of the tail indices.
+     * @return Table, with count 0 when fewer than two pallets would fit.
+     */
+    template <typename Key>
+    TailTable<Key> buildTail(const std::vector<Pallet>& input, const std::vector<int>& order, int capacity,
+                             const ObjectiveKey<Key>& objective, SolverWorkspace& workspace) {
+        int n = order.size();
+        std::vector<int>& items = workspace.tail;
+        items.clear();
+        if (capacity < 0) return TailTable<Key>{n, 0, DpRows<Key>(nullptr, 0), items, input};
+
+        const size_t columns = static_cast<size_t>(capacity) + 1;
+        size_t rows = HYBRID_TAIL_BYTES / sizeof(Key) / columns;
+        int k = static_cast<int>(std::min<size_t>(rows > 0 ? rows - 1 : 0, std::min(n / 2, HYBRID_TAIL_PALLETS)));
+        if (k < 2) return TailTable<Key>{n, 0, DpRows<Key>(nullptr, 0), items, input};
+
+        items.assign(order.end() - k, order.end());
+        std::sort(items.begin(), items.end());
+
+        DpRows<Key> dp = workspace.table<Key>(k + 1, columns);
+        std::fill(dp.row(0), dp.row(0) + columns, Key(0));
+        for (int j = 1; j <= k; ++j) {
+            const Pallet& p = input[items[j - 1]];
+            size_t peso = std::min<size_t>(p.weight, columns);
+            std::copy(dp.row(j - 1), dp.row(j - 1) + peso, dp.row(j));
+            if (peso < columns) {
+                relaxSegment(dp.row(j - 1) + peso, dp.row(j - 1), dp.row(j) + peso,
+                             static_cast<int>(columns - peso), objective.itemKey(p));
+            }
+        }
+        return TailTable<Key>{n - k, k, dp, items, input};
+    }
+}
+
+namespace {
+    /**
+     * @brief Finds, for each sorted pallet, the previous identical one.
+     *
+     * Identical pallets (same weight and profit) have the same ratio, so
+     * they appear in input order. Among loads that only differ in which
+     * twins they take, the tie rule prefers the lowest input indices, so
+     * the B&B never has to take a pallet after leaving out its twin.
+     *
+     * @param sorted Pallets sorted by decreasing profit/weight ratio.
+     * @param scratch Buffer for the positions sorted by weight and profit.
+     * @param twins Output: sorted position of the previous twin, or -1.
+     */
+    void findTwins(const std::vector<Pallet>& sorted, std::vector<int>& scratch, std::vector<int>& twins) {
+        int n = sorted.size();
+        scratch.resize(n);
+        for (int i = 0; i < n; ++i) scratch[i] = i;
+        std::sort(scratch.begin(), scratch.end(), [&sorted](int a, int b) {
+            if (sorted[a].weight != sorted[b].weight) return sorted[a].weight < sorted[b].weight;
+            if (sorted[a].profit != sorted[b].profit) return sorted[a].profit < sorted[b].profit;
+            return a < b;
+        });
+
+        twins.assign(n, -1);
+        for (int i = 1; i < n; ++i) {
+            const Pallet& a = sorted[scratch[i - 1]];
+            const Pallet& b = sorted[scratch[i]];
+            if (a.weight == b.weight && a.profit == b.profit) twins[scratch[i]] = scratch[i - 1];
+        }
+    }
+}
+
 /**
  * @brief Branch and bound implementation for ILP-style solution.
  *
  * Recursively explores subsets of pallets and prunes unpromising paths.
- * Tracks best profit, smallest number of pallets, and lightest weight.
+ * A path is pruned when its LP bound is strictly below the best profit,
+ * so ties are still explored. Loads are compared by their packed key
+ * (profit, then fewest pallets, then lightest weight) and exact ties use
+ * the same rule as KDynamic(). When the LP bound only ties the best
+ * profit, the node must also reach it with no more pallets than the best
+ * load, which needs at least ceil(missing profit / largest profit left)
+ * pallets; this prunes the many equal-profit loads of strongly correlated
+ * instances. The last pallets of the efficiency order are not branched
+ * on: at that depth the tail DP gives the best completion directly, which
+ * removes the deepest (and widest) levels of the tree. A pallet is only
+ * taken if its previous twin (see findTwins()) was.
  *
- * @param pallets All available pallets.
+ * @param pallets All available pallets, sorted by efficiency.
+ * @param order Input index of each sorted pallet.
+ * @param bounds LP bound and suffix profit maxima.
+ * @param twins Sorted position of the previous identical pallet, or -1.
+ * @param tail DP over the final pallets.
+ * @param objective Packed key layout of the instance.
  * @param idx Current index in recursion.
  * @param capacity Truck capacity.
  * @param currWeight Current weight used.
- * @param currProfit Current profit accumulated.
- * @param currSelection Currently selected pallet IDs.
- * @param bestSelection Best selection found.
- * @param bestProfit Best profit found.
- * @param bestWeight Best weight found (used to break ties).
+ * @param currKey Packed key of the current selection.
+ * @param currSelection Current selection, one bit per input index (a trail in the workspace arena).
+ * @param bestSelection Best selection found, same layout; overwritten word by word on improvement.
+ * @param bestKey Best key found.
  */
 namespace {
-    void branchAndBound(const std::vector<Pallet>& pallets, int idx, int capacity,
-                        int currWeight, int currProfit,
-                        std::vector<int>& currSelection,
-                        std::vector<int>& bestSelection,
-                        int& bestProfit, int& bestWeight) {
+    template <typename Key>
+    void branchAndBound(const std::vector<Pallet>& pallets, const std::vector<int>& order,
+                        const SearchBounds& bounds, const std::vector<int>& twins, const TailTable<Key>& tail,
+                        const ObjectiveKey<Key>& objective, int idx, int capacity,
+                        int currWeight, Key currKey,
+                        TrailBits currSelection,
+                        TrailBits bestSelection,
+                        Key& bestKey) {
+        ++searchNodes;
 
-        if (pallets.empty()) return;
+        if (idx == tail.depth && tail.count > 0) {
+            // Paletes finais: a DP dá a melhor forma de completar a carga atual
+            int remaining = capacity - currWeight;
+            Key candidate = currKey + tail.dp(tail.count, remaining);
+            if (candidate < bestKey) return;
+
+            int w = remaining;
+            for (int j = tail.count; j > 0; --j) {
+                if (tail.dp(j, w) != tail.dp(j - 1, w)) {
+                    currSelection.set(tail.items[j - 1]);
+                    w -= tail.input[tail.items[j - 1]].weight;
+                }
+            }
+            if (candidate > bestKey || preferOnTie(currSelection, bestSelection)) {
+                bestKey = candidate;
+                bestSelection.assign(currSelection);
+            }
+            for (int item : tail.items) currSelection.reset(item);
+            return;
+        }
 
         if (idx >= static_cast<int>(pallets.size())) {
-            if (currProfit > bestProfit ||
-                (currProfit == bestProfit && (
-                    currSelection.size() < bestSelection.size() ||
-                    (currSelection.size() == bestSelection.size() && currWeight < bestWeight)
-                ))) {
-                bestProfit = currProfit;
-                bestWeight = currWeight;
-                bestSelection = currSelection;
+            // Bits por índice original: nem cópias de vetores nem ordenações na folha
+            if (currKey > bestKey ||
+                (currKey == bestKey && preferOnTie(currSelection, bestSelection))) {
+                bestKey = currKey;
+                bestSelection.assign(currSelection);
             }
             return;
         }
 
+        // Nem a relaxação linear consegue igualar a melhor solução
+        long long currProfit = objective.profit(currKey);
+        long long bestProfit = objective.profit(bestKey);
+        long long bound = currProfit + bounds.lp.upperBound(idx, capacity - currWeight);
+        if (bound < bestProfit) return;
+
+        // Só empata no lucro: precisa de chegar lá sem mais paletes do que a melhor carga
+        if (bound == bestProfit && objective.countBits > 0 && bestKey >= objective.emptyKey()) {
+            long long needed = objective.count(currKey);
+            if (bestProfit > currProfit) needed += bounds.minPallets(idx, bestProfit - currProfit);
+            if (needed > objective.count(bestKey)) return;
+        }
+
+        // Com gémeas, só se leva esta palete se a anterior também foi levada
         const Pallet& current = pallets[idx];
-        if (currWeight + current.getWeight() <= capacity) {
-            currSelection.push_back(current.getID());
-            branchAndBound(pallets, idx + 1, capacity,
+        bool twinTaken = twins[idx] < 0 || currSelection.test(order[twins[idx]]);
+        if (twinTaken && currWeight + current.getWeight() <= capacity) {
+            currSelection.set(order[idx]);
+            branchAndBound(pallets, order, bounds, twins, tail, objective, idx + 1, capacity,
                            currWeight + current.getWeight(),
-                           currProfit + current.getProfit(),
-                           currSelection, bestSelection, bestProfit, bestWeight);
-            currSelection.pop_back();
+                           currKey + objective.itemKey(current),
+                           currSelection, bestSelection, bestKey);
+            currSelection.reset(order[idx]);
         }
 
         // Try excluding current pallet
-        branchAndBound(pallets, idx + 1, capacity,
-                       currWeight, currProfit,
-                       currSelection, bestSelection, bestProfit, bestWeight);
+        branchAndBound(pallets, order, bounds, twins, tail, objective, idx + 1, capacity,
+                       currWeight, currKey,
+                       currSelection, bestSelection, bestKey);
+    }
+}
+
+namespace {
+    template <typename Key>
+    void ilpWith(const std::vector<Pallet>& pallets, int capacity, const std::vector<int>& warmStart,
+                 SolverWorkspace& workspace, ILPResult& result) {
+        ObjectiveKey<Key> objective = ObjectiveKey<Key>::forInstance(pallets, capacity);
+        std::vector<int>& order = workspace.order;
+        efficiencyOrder(pallets, order);
+        std::vector<Pallet>& sorted = workspace.sorted;
+        sorted.clear();
+        for (int i : order) sorted.push_back(pallets[i]);
+        SearchBounds bounds(sorted, workspace);
+
+        // Seleção atual e incumbente vivem na arena do workspace, libertada no fim
+        int n = pallets.size();
+        workspace.trail.begin(2 * TrailArena::wordsFor(n));
+        TrailBits currentSelection = workspace.trail.take(n);
+        TrailBits bestSelection = workspace.trail.take(n);
+        Key bestKey = -1;
+
+        if (!warmStart.empty()) {
+            std::vector<char>& inSelection = workspace.flags;
+            repairSelection(sorted, capacity, warmStart, workspace.ids, inSelection);
+            bestKey = objective.emptyKey();
+            for (size_t i = 0; i < sorted.size(); ++i) {
+                if (inSelection[i]) {
+                    bestSelection.set(order[i]);
+                    bestKey += objective.itemKey(sorted[i]);
+                }
+            }
+        }
+
+        findTwins(sorted, workspace.ids, workspace.twins);
+        TailTable<Key> tail = buildTail<Key>(pallets, order, capacity, objective, workspace);
+        branchAndBound<Key>(sorted, order, bounds, workspace.twins, tail, objective, 0, capacity, 0, objective.emptyKey(),
+                            currentSelection, bestSelection, bestKey);
+
+        trailIndices(bestSelection, n, workspace.best);
+        workspace.trail.release();
+        writeResult(pallets, workspace.best, objective.profit(bestKey), result);
     }
 }
 
@@ -293,31 +975,46 @@ namespace {
  * @brief Solves the knapsack problem using ILP via branch and bound.
  *
  * Returns the best selection based on profit, pallet count, and total weight.
+ * When a warm start is given it is repaired to feasibility and used as the
+ * initial incumbent, which lets the LP bound prune from the first node.
+ * Up to 16 pallets the Gray-code enumeration of solver_templates.h runs
+ * instead, and the warm start is not needed.
  *
  * @param pallets List of pallets.
  * @param capacity Truck capacity.
+ * @param warmStart Pallet IDs of a previous solution (may be empty).
  * @return ILPResult containing selected pallets, total weight, and profit.
  */
-ILPResult solveILP(const std::vector<Pallet>& pallets, int capacity) {
-    ILPResult result;
-    std::vector<int> currentSelection;
-    int bestProfit = 0;
-    int bestWeight = INT_MAX;
+void solveILP(const std::vector<Pallet>& pallets, int capacity, const std::vector<int>& warmStart,
+              SolverWorkspace& workspace, ILPResult& result) {
+    searchNodes = 0;
 
-    auto start = std::chrono::high_resolution_clock::now();
-    branchAndBound(pallets, 0, capacity, 0, 0, currentSelection, result.selectedPallets, bestProfit, bestWeight);
-    auto end = std::chrono::high_resolution_clock::now();
+    // Até 16 paletes: enumeração em código de Gray sem alocações (solver_templates.h)
+    if (tryEnumerateSmall(pallets, capacity, result)) return;
 
-    result.totalProfit = bestProfit;
-    result.totalWeight = 0;
-    for (int id : result.selectedPallets) {
-        auto it = std::find_if(pallets.begin(), pallets.end(), [id](const Pallet& p) {
-            return p.getID() == id;
-        });
-        if (it != pallets.end()) {
-            result.totalWeight += it->getWeight();
-        }
+    switch (chooseKeyWidth(pallets, capacity)) {
+        case KeyWidth::Bits32: ilpWith<int32_t>(pallets, capacity, warmStart, workspace, result); break;
+        case KeyWidth::Bits64: ilpWith<int64_t>(pallets, capacity, warmStart, workspace, result); break;
+        default: ilpWith<__int128>(pallets, capacity, warmStart, workspace, result); break;
     }
+}
+
+/**
+ * @brief Returns the nodes visited by the last branch and bound of this thread.
+ *
+ * @return Count set by solveILP().
+ */
+long long lastSearchNodes() {
+    return searchNodes;
+}
+
+/**
+ * @brief Runs solveILP() on a workspace of its own.
+ */
+ILPResult solveILP(const std::vector<Pallet>& pallets, int capacity, const std::vector<int>& warmStart) {
+    SolverWorkspace workspace;
+    ILPResult result;
+    solveILP(pallets, capacity, warmStart, workspace, result);
     return result;
 }
 
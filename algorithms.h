@@ -22,10 +22,13 @@
  */
 struct ILPResult {
     std::vector<int> selectedPallets; // pallet IDs
-    int totalProfit;
+    long long totalProfit;
     int totalWeight;
 };
 
+class SolverWorkspace; // workspace.h
+struct DpMemoryReport; // dp_storage.h
+
 /**
  * @brief Solves the knapsack problem using brute-force recursion.
  * 
@@ -33,7 +36,37 @@ struct ILPResult {
  * @param pallets Vector of available pallets.
  * @return Maximum profit achievable.
  */
-int KBruteForce(int capacity, const std::vector<Pallet>& pallets);
+long long KBruteForce(int capacity, const std::vector<Pallet>& pallets);
+
+/**
+ * @brief KBruteForce() on the buffers of a reusable workspace.
+ *
+ * @param capacity Maximum capacity of the truck.
+ * @param pallets Vector of available pallets.
+ * @param workspace Buffers reused across solves.
+ * @return Maximum profit achievable.
+ */
+long long KBruteForce(int capacity, const std::vector<Pallet>& pallets, SolverWorkspace& workspace);
+
+/**
+ * @brief Solves the knapsack problem using brute-force recursion without printing.
+ *
+ * @param pallets Vector of available pallets.
+ * @param capacity Maximum capacity of the truck.
+ * @return Struct containing selected pallet IDs, profit, and total weight.
+ */
+ILPResult solveBruteForce(const std::vector<Pallet>& pallets, int capacity);
+
+/**
+ * @brief solveBruteForce() on the buffers of a reusable workspace.
+ *
+ * @param pallets Vector of available pallets.
+ * @param capacity Maximum capacity of the truck.
+ * @param workspace Buffers reused across solves.
+ * @param result Reference to store the solution (its storage is reused).
+ */
+void solveBruteForce(const std::vector<Pallet>& pallets, int capacity, SolverWorkspace& workspace,
+                     ILPResult& result);
 
 /**
  * @brief Solves the knapsack problem using dynamic programming.
@@ -42,7 +75,78 @@ int KBruteForce(int capacity, const std::vector<Pallet>& pallets);
  * @param pallets Vector of available pallets.
  * @return Maximum profit achievable.
  */
-int KDynamic(int capacity, const std::vector<Pallet>& pallets);
+long long KDynamic(int capacity, const std::vector<Pallet>& pallets);
+
+/**
+ * @brief KDynamic() on the buffers of a reusable workspace.
+ *
+ * @param capacity Maximum capacity of the truck.
+ * @param pallets Vector of available pallets.
+ * @param workspace Buffers reused across solves.
+ * @return Maximum profit achievable.
+ */
+long long KDynamic(int capacity, const std::vector<Pallet>& pallets, SolverWorkspace& workspace);
+
+/**
+ * @brief Solves the knapsack problem using dynamic programming without printing.
+ *
+ * Same table and tie-breaking as KDynamic(), but returns the full selection.
+ * All exact solvers rank loads by profit, then fewest pallets, then lowest
+ * weight, and pick the same selection when loads tie on all three.
+ *
+ * @param pallets Vector of available pallets.
+ * @param capacity Maximum capacity of the truck.
+ * @return Struct containing selected pallet IDs, profit, and total weight.
+ */
+ILPResult solveDynamic(const std::vector<Pallet>& pallets, int capacity);
+
+/**
+ * @brief solveDynamic() that also reports the memory of its DP table.
+ *
+ * The report covers the table allocated by this solve (all zeros when no
+ * table was needed). Huge page residency is read from /proc/self/smaps
+ * while the table is still alive, so only use this overload for reports.
+ *
+ * @param pallets Vector of available pallets.
+ * @param capacity Maximum capacity of the truck.
+ * @param memory Output report of the table.
+ * @return Struct containing selected pallet IDs, profit, and total weight.
+ */
+ILPResult solveDynamic(const std::vector<Pallet>& pallets, int capacity, DpMemoryReport& memory);
+
+/**
+ * @brief Cells of the DP table written by the last solveDynamic() call of this thread.
+ */
+struct DpSweepReport {
+    long long cellsTouched;  // células calculadas ou copiadas
+    long long cellsTotal;    // células da tabela completa, 0 se não houve tabela
+};
+
+/**
+ * @brief Returns how much of its table the last DP on this thread touched.
+ *
+ * The full-table DP only fills, in each row, the columns between what the
+ * remaining pallets can still reach and the prefix weight sum. The
+ * cache-blocked DP touches every cell; the small-instance enumeration none.
+ *
+ * @return Report of the last solve.
+ */
+DpSweepReport lastDpSweepReport();
+
+/**
+ * @brief solveDynamic() on the buffers of a reusable workspace.
+ *
+ * The DP table lives in the workspace, so repeated solves of instances no
+ * larger than a previous one allocate nothing.
+ *
+ * @param pallets Vector of available pallets.
+ * @param capacity Maximum capacity of the truck.
+ * @param workspace Buffers reused across solves.
+ * @param result Reference to store the solution (its storage is reused).
+ * @param memory Optional report of the table of this solve (reads /proc/self/smaps).
+ */
+void solveDynamic(const std::vector<Pallet>& pallets, int capacity, SolverWorkspace& workspace,
+                  ILPResult& result, DpMemoryReport* memory = nullptr);
 
 /**
  * @brief Solves the knapsack problem using a greedy heuristic approximation.
@@ -51,16 +155,53 @@ int KDynamic(int capacity, const std::vector<Pallet>& pallets);
  * @param pallets Vector of available pallets.
  * @return Approximate profit achieved.
  */
-int KProxy(int capacity, const std::vector<Pallet>& pallets);
+long long KProxy(int capacity, const std::vector<Pallet>& pallets);
+
+/**
+ * @brief KProxy() on the buffers of a reusable workspace.
+ *
+ * @param capacity Maximum capacity of the truck.
+ * @param pallets Vector of available pallets.
+ * @param workspace Buffers reused across solves.
+ * @return Approximate profit achieved.
+ */
+long long KProxy(int capacity, const std::vector<Pallet>& pallets, SolverWorkspace& workspace);
 
 /**
  * @brief Solves the knapsack problem using a custom ILP-style branch-and-bound method.
  * 
+ * A warm start (e.g. the selection of a similar, previously solved instance)
+ * is repaired to feasibility and used as the initial incumbent.
+ *
  * @param pallets Vector of available pallets.
  * @param capacity Maximum capacity of the truck.
+ * @param warmStart Pallet IDs of a previous solution, empty for a cold start.
  * @return Struct containing selected pallet IDs, profit, and total weight.
  */
-ILPResult solveILP(const std::vector<Pallet>& pallets, int capacity);
+ILPResult solveILP(const std::vector<Pallet>& pallets, int capacity,
+                   const std::vector<int>& warmStart = {});
+
+/**
+ * @brief solveILP() on the buffers of a reusable workspace.
+ *
+ * @param pallets Vector of available pallets.
+ * @param capacity Maximum capacity of the truck.
+ * @param warmStart Pallet IDs of a previous solution, empty for a cold start.
+ * @param workspace Buffers reused across solves.
+ * @param result Reference to store the solution (its storage is reused).
+ */
+void solveILP(const std::vector<Pallet>& pallets, int capacity, const std::vector<int>& warmStart,
+              SolverWorkspace& workspace, ILPResult& result);
+
+/**
+ * @brief Returns how many branch-and-bound nodes the last solveILP() call of this thread visited.
+ *
+ * Instances solved by enumeration report 0. A better initial incumbent
+ * (warm start) can only lower this count.
+ *
+ * @return Nodes of the last search.
+ */
+long long lastSearchNodes();
 
 
 #endif
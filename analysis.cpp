@@ -0,0 +1,461 @@
+/**
+ * @file analysis.cpp
+ * @brief Implementation of the DP-based what-if queries.
+ *
+ * @author Luís Martins e João Taveira
+ * @date 2025-05-20
+ */
+
+#include "analysis.h"
+#include "dispatch.h"
+#include "dp_storage.h"
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <queue>
+
+namespace {
+    /**
+     * @brief Whether every DP value of the instance fits a 32-bit row.
+     * @param pallets Pallets of the instance.
+     * @return true if the sum of the positive profits is at most INT32_MAX.
+     */
+    bool fitsInt32(const std::vector<Pallet>& pallets) {
+        long long sum = 0;
+        for (const auto& p : pallets) sum += std::max(p.profit, 0);
+        return sum <= INT32_MAX;
+    }
+
+    // Kernels da largura da linha: 32 bits enquanto os lucros cabem, 64 bits depois
+    void relaxRow(const int32_t* prev, int32_t* next, const Pallet& p, int capacity) {
+        dpKernels().relax32(prev, next, p.weight, capacity, p.profit);
+    }
+
+    void relaxRow(const int64_t* prev, int64_t* next, const Pallet& p, int capacity) {
+        dpKernels().relax64(prev, next, p.weight, capacity, p.profit);
+    }
+
+    int32_t bestSplit(const int32_t* before, const int32_t* after, int capacity) {
+        return dpKernels().bestSplit32(before, after, capacity);
+    }
+
+    int64_t bestSplit(const int64_t* before, const int64_t* after, int capacity) {
+        return dpKernels().bestSplit64(before, after, capacity);
+    }
+}
+
+CapacityProfile::CapacityProfile(const std::vector<Pallet>& pallets, int maxCapacity)
+    : solver(maxCapacity) {
+    solver.addPallets(pallets);
+}
+
+long long CapacityProfile::profitAt(int capacity) const {
+    const std::vector<long long>& profits = getProfits();
+    return profits[std::min(std::max(capacity, 0), getMaxCapacity())];
+}
+
+int CapacityProfile::minCapacityFor(long long targetProfit) const {
+    const std::vector<long long>& profits = getProfits();
+    auto it = std::lower_bound(profits.begin(), profits.end(), targetProfit);
+    if (it == profits.end()) return -1;
+    return static_cast<int>(it - profits.begin());
+}
+
+bool CapacityProfile::saveCSV(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) return false;
+
+    const std::vector<long long>& profits = getProfits();
+    file << "Capacity,Profit\n";
+    for (size_t w = 0; w < profits.size(); ++w) {
+        file << w << "," << profits[w] << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+namespace {
+    template <typename Row>
+    std::vector<PalletSensitivity> sensitivityWith(const std::vector<Pallet>& pallets, int capacity) {
+        int n = pallets.size();
+        size_t columns = capacity + 1;
+
+        // prefix[i]: paletes 0..i-1; suffix[i]: paletes i..n-1 (linhas alinhadas num só bloco)
+        DpMatrix<Row> prefix(n + 1, columns);
+        DpMatrix<Row> suffix(n + 1, columns);
+
+        for (int i = 0; i < n; ++i) {
+            relaxRow(prefix.row(i), prefix.row(i + 1), pallets[i], capacity);
+        }
+
+        for (int i = n - 1; i >= 0; --i) {
+            relaxRow(suffix.row(i + 1), suffix.row(i), pallets[i], capacity);
+        }
+
+        std::vector<PalletSensitivity> result(n);
+
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(static)
+#endif
+        for (int i = 0; i < n; ++i) {
+            const Row* before = prefix.row(i);
+            const Row* after = suffix.row(i + 1);
+
+            // Melhor divisão da capacidade entre as paletes anteriores e posteriores
+            auto merge = [&](int cap) { return static_cast<long long>(bestSplit(before, after, cap)); };
+
+            PalletSensitivity& s = result[i];
+            s.id = pallets[i].id;
+            s.forcedOut = merge(capacity);
+            s.forcedIn = pallets[i].weight <= capacity
+                             ? merge(capacity - pallets[i].weight) + pallets[i].profit
+                             : -1;
+            s.marginalValue = s.forcedIn < 0 ? -s.forcedOut : s.forcedIn - s.forcedOut;
+        }
+
+        return result;
+    }
+}
+
+std::vector<PalletSensitivity> sensitivityAnalysis(const std::vector<Pallet>& pallets, int capacity) {
+    capacity = std::max(capacity, 0);
+    if (fitsInt32(pallets)) return sensitivityWith<int32_t>(pallets, capacity);
+    return sensitivityWith<int64_t>(pallets, capacity);
+}
+
+namespace {
+    template <typename Row>
+    std::vector<ILPResult> kBestWith(const std::vector<Pallet>& pallets, int capacity, int k) {
+        int n = pallets.size();
+        size_t columns = capacity + 1;
+        std::vector<ILPResult> solutions;
+
+        // dp(i, w): melhor lucro com as paletes 0..i-1 e peso <= w
+        DpMatrix<Row> dp(n + 1, columns);
+        for (int i = 1; i <= n; ++i) {
+            relaxRow(dp.row(i - 1), dp.row(i), pallets[i - 1], capacity);
+        }
+
+        // Decisões partilhadas: cada nó é uma palete incluída e aponta para o anterior
+        struct Link {
+            int parent;
+            int item;
+        };
+        std::vector<Link> links;
+
+        struct Partial {
+            long long priority; // lucro acumulado + melhor conclusão possível
+            long long profit;
+            int i;
+            int w;
+            int link;
+
+            bool operator<(const Partial& other) const { return priority < other.priority; }
+        };
+
+        std::priority_queue<Partial> open;
+        open.push(Partial{dp(n, capacity), 0, n, capacity, -1});
+
+        while (!open.empty() && static_cast<int>(solutions.size()) < k) {
+            Partial top = open.top();
+            open.pop();
+
+            if (top.i == 0) {
+                ILPResult load;
+                load.totalProfit = top.profit;
+                load.totalWeight = 0;
+                for (int l = top.link; l >= 0; l = links[l].parent) {
+                    load.selectedPallets.push_back(pallets[links[l].item].id);
+                    load.totalWeight += pallets[links[l].item].weight;
+                }
+                solutions.push_back(std::move(load));
+                continue;
+            }
+
+            int item = top.i - 1;
+            const Row* below = dp.row(item);
+
+            // Excluir a palete
+            open.push(Partial{top.profit + below[top.w], top.profit, item, top.w, top.link});
+
+            // Incluir a palete
+            int peso = pallets[item].weight;
+            if (peso <= top.w) {
+                long long profit = top.profit + pallets[item].profit;
+                links.push_back(Link{top.link, item});
+                open.push(Partial{profit + below[top.w - peso], profit, item, top.w - peso,
+                                  static_cast<int>(links.size()) - 1});
+            }
+        }
+
+        return solutions;
+    }
+}
+
+std::vector<ILPResult> kBestSolutions(const std::vector<Pallet>& pallets, int capacity, int k) {
+    capacity = std::max(capacity, 0);
+    if (k <= 0) return {};
+    if (fitsInt32(pallets)) return kBestWith<int32_t>(pallets, capacity, k);
+    return kBestWith<int64_t>(pallets, capacity, k);
+}
+
+OptimalCount countOptimalSolutions(const std::vector<Pallet>& pallets, int capacity, uint64_t modulus) {
+    using u128 = unsigned __int128;
+    const u128 maxCount = ~u128(0);
+
+    capacity = std::max(capacity, 0);
+    modulus = std::max<uint64_t>(modulus, 1);
+
+    // Linhas anteriores e atuais: lucro, contagem de 128 bits, saturação e contagem modular
+    std::vector<long long> dpPrev(capacity + 1, 0), dpCurr(capacity + 1);
+    std::vector<u128> waysPrev(capacity + 1, 1), waysCurr(capacity + 1);
+    std::vector<char> satPrev(capacity + 1, 0), satCurr(capacity + 1);
+    std::vector<uint64_t> modPrev(capacity + 1, 1 % modulus), modCurr(capacity + 1);
+
+    for (const auto& p : pallets) {
+        for (int w = 0; w <= capacity; ++w) {
+            long long exclui = dpPrev[w];
+            long long inclui = p.weight <= w ? dpPrev[w - p.weight] + p.profit : -1;
+            dpCurr[w] = std::max(exclui, inclui);
+
+            u128 ways = 0;
+            bool sat = false;
+            uint64_t mod = 0;
+            if (exclui == dpCurr[w]) {
+                ways = waysPrev[w];
+                sat = satPrev[w];
+                mod = modPrev[w];
+            }
+            if (inclui == dpCurr[w]) {
+                int from = w - p.weight;
+                sat = sat || satPrev[from] || ways > maxCount - waysPrev[from];
+                ways = sat ? maxCount : ways + waysPrev[from];
+                mod = static_cast<uint64_t>((static_cast<u128>(mod) + modPrev[from]) % modulus);
+            }
+            waysCurr[w] = ways;
+            satCurr[w] = sat;
+            modCurr[w] = mod;
+        }
+        dpPrev.swap(dpCurr);
+        waysPrev.swap(waysCurr);
+        satPrev.swap(satCurr);
+        modPrev.swap(modCurr);
+    }
+
+    return OptimalCount{dpPrev[capacity], waysPrev[capacity], satPrev[capacity] != 0,
+                        modPrev[capacity], modulus};
+}
+
+namespace {
+    template <typename Row>
+    unsigned long long enumerateWith(const std::vector<Pallet>& pallets, int capacity,
+                                     const std::function<bool(const ILPResult&)>& sink) {
+        int n = pallets.size();
+        size_t columns = capacity + 1;
+
+        // dp(i, w): melhor lucro com as paletes i..n-1 e peso <= w (assim o caminho segue a ordem de entrada)
+        DpMatrix<Row> dp(n + 1, columns);
+        for (int i = n - 1; i >= 0; --i) {
+            relaxRow(dp.row(i + 1), dp.row(i), pallets[i], capacity);
+        }
+
+        // Pilha explícita: (palete, capacidade, próxima escolha a tentar)
+        struct Frame {
+            int i;
+            int w;
+            int choice; // 0 = excluir, 1 = incluir, 2 = esgotado
+        };
+
+        ILPResult load;
+        load.totalProfit = dp(0, capacity);
+        load.totalWeight = 0;
+
+        unsigned long long streamed = 0;
+        std::vector<Frame> stack{Frame{0, capacity, 0}};
+        std::vector<char> taken;
+
+        while (!stack.empty()) {
+            Frame& f = stack.back();
+
+            if (f.i == n) {
+                ++streamed;
+                if (!sink(load)) return streamed;
+                stack.pop_back();
+            } else if (f.choice == 0) {
+                f.choice = 1;
+                if (dp(f.i + 1, f.w) == dp(f.i, f.w)) {
+                    taken.push_back(0);
+                    stack.push_back(Frame{f.i + 1, f.w, 0});
+                }
+                continue;
+            } else if (f.choice == 1) {
+                f.choice = 2;
+                const Pallet& p = pallets[f.i];
+                if (p.weight <= f.w &&
+                    dp(f.i + 1, f.w - p.weight) + p.profit == dp(f.i, f.w)) {
+                    taken.push_back(1);
+                    load.selectedPallets.push_back(p.id);
+                    load.totalWeight += p.weight;
+                    stack.push_back(Frame{f.i + 1, f.w - p.weight, 0});
+                }
+                continue;
+            } else {
+                stack.pop_back();
+            }
+
+            // Desfazer a escolha que levou a este nó
+            if (!taken.empty()) {
+                if (taken.back()) {
+                    load.selectedPallets.pop_back();
+                    load.totalWeight -= pallets[stack.back().i].weight;
+                }
+                taken.pop_back();
+            }
+        }
+
+        return streamed;
+    }
+}
+
+unsigned long long enumerateOptimalSolutions(const std::vector<Pallet>& pallets, int capacity,
+                                             const std::function<bool(const ILPResult&)>& sink) {
+    capacity = std::max(capacity, 0);
+    if (fitsInt32(pallets)) return enumerateWith<int32_t>(pallets, capacity, sink);
+    return enumerateWith<int64_t>(pallets, capacity, sink);
+}
+
+std::string toString(unsigned __int128 value) {
+    if (value == 0) return "0";
+    std::string digits;
+    while (value > 0) {
+        digits.push_back(static_cast<char>('0' + static_cast<int>(value % 10)));
+        value /= 10;
+    }
+    std::reverse(digits.begin(), digits.end());
+    return digits;
+}
+
+namespace {
+    const long long UNREACHABLE = LLONG_MIN / 2;
+
+    /**
+     * @brief Fewest pallets among the loads with the optimal profit.
+     *
+     * No larger count can be on the Pareto front, so it bounds the count
+     * dimension of countTable(). One row of (profit, count) pairs, O(n * capacity).
+     */
+    int minPalletsForOptimum(const std::vector<Pallet>& pallets, int capacity) {
+        std::vector<long long> dp(capacity + 1, 0);
+        std::vector<int> count(capacity + 1, 0);
+
+        for (const auto& p : pallets) {
+            for (int w = capacity; w >= p.weight; --w) {
+                long long inclui = dp[w - p.weight] + p.profit;
+                int incluiCount = count[w - p.weight] + 1;
+                if (inclui > dp[w] || (inclui == dp[w] && incluiCount < count[w])) {
+                    dp[w] = inclui;
+                    count[w] = incluiCount;
+                }
+            }
+        }
+        return count[capacity];
+    }
+
+    /**
+     * @brief DP over (capacity, exact count): table(w, c).
+     *
+     * When bits is not null it receives one decision bit per (pallet, w, c).
+     */
+    DpMatrix<long long> countTable(const std::vector<Pallet>& pallets, int capacity, int maxCount,
+                                   std::vector<uint64_t>* bits) {
+        size_t stride = maxCount + 1;
+        size_t cells = (capacity + 1) * stride;
+
+        // O bloco vem a zeros: só a coluna c = 0 é atingível à partida
+        DpMatrix<long long> table(capacity + 1, stride);
+        for (int w = 0; w <= capacity; ++w) std::fill(table.row(w) + 1, table.row(w) + stride, UNREACHABLE);
+        if (bits) bits->assign((pallets.size() * cells + 63) / 64, 0);
+
+        for (size_t i = 0; i < pallets.size(); ++i) {
+            int peso = pallets[i].weight;
+            long long lucro = pallets[i].profit;
+
+            for (int w = capacity; w >= peso; --w) {
+                long long* row = table.row(w);
+                const long long* src = table.row(w - peso);
+
+                if (!bits && peso > 0) {
+                    // Linhas distintas: ciclo sem dependências, vetorizável
+                    for (int c = 0; c < maxCount; ++c) row[c + 1] = std::max(row[c + 1], src[c] + lucro);
+                    continue;
+                }
+
+                // Peso 0 (src == row) ou com registo de decisões: contagem decrescente
+                for (int c = maxCount - 1; c >= 0; --c) {
+                    if (src[c] >= 0 && src[c] + lucro > row[c + 1]) {
+                        row[c + 1] = src[c] + lucro;
+                        if (bits) {
+                            size_t bit = i * cells + w * stride + c + 1;
+                            (*bits)[bit / 64] |= uint64_t(1) << (bit % 64);
+                        }
+                    }
+                }
+            }
+        }
+        return table;
+    }
+}
+
+std::vector<ParetoPoint> paretoFront(const std::vector<Pallet>& pallets, int capacity) {
+    capacity = std::max(capacity, 0);
+    int maxCount = minPalletsForOptimum(pallets, capacity);
+
+    DpMatrix<long long> table = countTable(pallets, capacity, maxCount, nullptr);
+
+    // Lucros negativos são estados inatingíveis (UNREACHABLE somado a lucros)
+    std::vector<ParetoPoint> front;
+    long long bestSoFar = -1;
+    for (int c = 0; c <= maxCount; ++c) {
+        long long profit = table(capacity, c);
+        if (profit < 0 || profit <= bestSoFar) continue;
+        bestSoFar = profit;
+
+        // O lucro é não decrescente em w: procurar o primeiro peso que o atinge
+        int lo = 0, hi = capacity;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (table(mid, c) >= profit) hi = mid;
+            else lo = mid + 1;
+        }
+        front.push_back(ParetoPoint{c, profit, lo});
+    }
+    return front;
+}
+
+ILPResult paretoLoad(const std::vector<Pallet>& pallets, const ParetoPoint& point) {
+    int capacity = std::max(point.minWeight, 0);
+    int maxCount = std::max(point.count, 0);
+    size_t stride = maxCount + 1;
+    size_t cells = (capacity + 1) * stride;
+
+    std::vector<uint64_t> bits;
+    DpMatrix<long long> table = countTable(pallets, capacity, maxCount, &bits);
+
+    ILPResult result;
+    result.totalProfit = std::max(table(capacity, maxCount), 0LL);
+    result.totalWeight = 0;
+
+    int w = capacity;
+    int c = maxCount;
+    for (int i = static_cast<int>(pallets.size()) - 1; i >= 0 && c > 0; --i) {
+        size_t bit = i * cells + w * stride + c;
+        if ((bits[bit / 64] >> (bit % 64)) & 1) {
+            result.selectedPallets.push_back(pallets[i].id);
+            result.totalWeight += pallets[i].weight;
+            w -= pallets[i].weight;
+            --c;
+        }
+    }
+
+    std::reverse(result.selectedPallets.begin(), result.selectedPallets.end());
+    return result;
+}
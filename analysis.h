@@ -0,0 +1,219 @@
+/**
+ * @file analysis.h
+ * @brief What-if queries built on top of the dynamic programming table.
+ *
+ * These answer questions that would otherwise need one KDynamic() call per
+ * scenario (one per truck size, one per pallet, ...) from a single DP pass.
+ *
+ * @author Luís Martins e João Taveira
+ * @date 2025-05-20
+ */
+
+#ifndef ANALYSIS_H
+#define ANALYSIS_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Pallet.h"
+#include "algorithms.h"
+#include "incremental.h"
+
+/**
+ * @brief Optimal profit for every truck capacity from 0 up to a maximum.
+ *
+ * The last DP row of a single pass already holds all of them; the decision
+ * bits kept by IncrementalKnapsack allow rebuilding the load of any size.
+ */
+class CapacityProfile {
+public:
+    /**
+     * @brief Runs the DP once for the largest truck.
+     *
+     * @param pallets Vector of available pallets.
+     * @param maxCapacity Largest truck capacity of interest.
+     */
+    CapacityProfile(const std::vector<Pallet>& pallets, int maxCapacity);
+
+    /**
+     * @brief Returns the largest capacity covered.
+     * @return Capacity.
+     */
+    int getMaxCapacity() const { return solver.getCapacity(); }
+
+    /**
+     * @brief Returns the optimal profit for every capacity 0..getMaxCapacity().
+     * @return Profit indexed by capacity.
+     */
+    const std::vector<long long>& getProfits() const { return solver.getRow(); }
+
+    /**
+     * @brief Returns the optimal profit of a truck.
+     * @param capacity Truck capacity (clamped to 0..getMaxCapacity()).
+     * @return Maximum achievable profit.
+     */
+    long long profitAt(int capacity) const;
+
+    /**
+     * @brief Rebuilds the optimal load of a truck.
+     *
+     * Ties follow IncrementalKnapsack (earliest pallets kept), not the
+     * fewest-pallets rule of KDynamic().
+     *
+     * @param capacity Truck capacity (clamped to 0..getMaxCapacity()).
+     * @return Struct containing selected pallet IDs, profit, and total weight.
+     */
+    ILPResult selectionFor(int capacity) const { return solver.getResult(capacity); }
+
+    /**
+     * @brief Finds the smallest truck that reaches a target profit.
+     *
+     * The profile is non-decreasing, so this is a binary search.
+     *
+     * @param targetProfit Profit to reach.
+     * @return Minimum capacity, or -1 if not even getMaxCapacity() reaches it.
+     */
+    int minCapacityFor(long long targetProfit) const;
+
+    /**
+     * @brief Writes the profile as a "Capacity,Profit" CSV file.
+     * @param filename Path of the output file.
+     * @return true if the file was written, false otherwise.
+     */
+    bool saveCSV(const std::string& filename) const;
+
+private:
+    IncrementalKnapsack solver;
+};
+
+/**
+ * @brief Optimum with one pallet forced on or off the truck.
+ */
+struct PalletSensitivity {
+    int id;
+    long long forcedIn;      // lucro ótimo com a palete obrigatória, -1 se não cabe
+    long long forcedOut;     // lucro ótimo sem a palete
+    long long marginalValue; // forcedIn - forcedOut (negativo: a palete prejudica a carga)
+};
+
+/**
+ * @brief Computes the forced-in and forced-out optimum of every pallet.
+ *
+ * Prefix rows (pallets before i) and suffix rows (pallets after i) are built
+ * once; each pallet is then answered by merging its two rows in O(capacity),
+ * so the whole analysis is O(n * capacity) instead of n re-solves. The merge
+ * loop is parallel when compiled with OpenMP. Rows are 32-bit while the
+ * profit sum fits, 64-bit otherwise.
+ *
+ * @param pallets Vector of available pallets.
+ * @param capacity Maximum capacity of the truck.
+ * @return One entry per pallet, in input order.
+ */
+std::vector<PalletSensitivity> sensitivityAnalysis(const std::vector<Pallet>& pallets, int capacity);
+
+/**
+ * @brief Enumerates the k best distinct feasible loads, in decreasing profit order.
+ *
+ * Every load is a path from (n, capacity) to row 0 in the DP table, and the
+ * table gives the exact best completion of every partial path. A best-first
+ * search over partial paths, ordered by profit so far plus that completion,
+ * therefore pops full loads in profit order, and each extra load only costs
+ * O(n log) on top of the single DP pass. Decisions are shared between paths
+ * through parent links, so partial loads are never copied. The table is
+ * 32-bit while the profit sum fits, 64-bit otherwise.
+ *
+ * @param pallets Vector of available pallets.
+ * @param capacity Maximum capacity of the truck.
+ * @param k Number of loads wanted.
+ * @return Up to k loads (fewer if there are not that many feasible ones).
+ */
+std::vector<ILPResult> kBestSolutions(const std::vector<Pallet>& pallets, int capacity, int k);
+
+/**
+ * @brief Number of distinct optimal loads of an instance.
+ */
+struct OptimalCount {
+    long long profit;
+    unsigned __int128 count; // exato enquanto saturated == false
+    bool saturated;          // a contagem excedeu 2^128 - 1
+    uint64_t countModulo;    // contagem exata módulo modulus
+    uint64_t modulus;
+};
+
+/**
+ * @brief Counts the distinct loads that reach the optimal profit.
+ *
+ * The count of optimal paths is carried alongside the profit in the same DP
+ * pass, using two rolling rows, both as a saturating 128-bit integer and
+ * modulo a user-given number for counts that do not fit.
+ *
+ * @param pallets Vector of available pallets.
+ * @param capacity Maximum capacity of the truck.
+ * @param modulus Modulus for the modular count (must be > 0).
+ * @return Optimal profit and number of optimal loads.
+ */
+OptimalCount countOptimalSolutions(const std::vector<Pallet>& pallets, int capacity,
+                                   uint64_t modulus = 1000000007ULL);
+
+/**
+ * @brief Streams every optimal load to a sink without storing them.
+ *
+ * Walks the DP table depth-first along the transitions that keep the
+ * optimum; every branch taken leads to an optimal load, so each load costs
+ * O(n) and memory is one table plus the current path.
+ *
+ * @param pallets Vector of available pallets.
+ * @param capacity Maximum capacity of the truck.
+ * @param sink Called for each optimal load; return false to stop.
+ * @return Number of loads passed to the sink.
+ */
+unsigned long long enumerateOptimalSolutions(const std::vector<Pallet>& pallets, int capacity,
+                                             const std::function<bool(const ILPResult&)>& sink);
+
+/**
+ * @brief One non-dominated trade-off between profit and number of pallets.
+ */
+struct ParetoPoint {
+    int count;        // número de paletes
+    long long profit; // melhor lucro com exatamente count paletes
+    int minWeight;    // menor peso que atinge esse lucro com count paletes
+};
+
+/**
+ * @brief Computes the Pareto front of (profit, pallet count) within capacity.
+ *
+ * Runs a DP over (capacity, exact pallet count). The count dimension is
+ * contiguous in memory, so the update of one capacity is a plain max over
+ * two arrays that the compiler vectorizes. Counts stop at the fewest pallets
+ * that reach the overall optimum, since every larger count is dominated.
+ * A point is kept when no smaller count reaches its profit, and each point
+ * reports the lightest load achieving it.
+ *
+ * @param pallets Vector of available pallets.
+ * @param capacity Maximum capacity of the truck.
+ * @return Points in increasing pallet count (and profit).
+ */
+std::vector<ParetoPoint> paretoFront(const std::vector<Pallet>& pallets, int capacity);
+
+/**
+ * @brief Rebuilds the load of one Pareto point.
+ *
+ * Repeats the DP of paretoFront() up to the requested count while keeping
+ * one decision bit per (pallet, capacity, count), i.e. n * capacity * count
+ * bits, so it is meant for the point the planner actually picked.
+ *
+ * @param pallets Vector of available pallets.
+ * @param point Point returned by paretoFront().
+ * @return Struct containing selected pallet IDs, profit, and total weight.
+ */
+ILPResult paretoLoad(const std::vector<Pallet>& pallets, const ParetoPoint& point);
+
+/**
+ * @brief Converts a 128-bit count to decimal text.
+ * @param value Value to convert.
+ * @return Decimal representation.
+ */
+std::string toString(unsigned __int128 value);
+
+#endif
@@ -0,0 +1,113 @@
+/**
+ * @file batch.cpp
+ * @brief Implementation of the batch DP over many small instances.
+ *
+ * @author Luís Martins e João Taveira
+ * @date 2025-05-20
+ */
+
+#include "batch.h"
+#include "dispatch.h"
+#include "objective.h"
+#include "workspace.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace {
+    /**
+     * @brief Whether an instance is small enough for the shared buffers.
+     */
+    bool fitsBatch(const TruckInstance& instance) {
+        return instance.capacity >= 0 && instance.capacity <= BATCH_MAX_CAPACITY &&
+               instance.pallets.size() <= static_cast<size_t>(BATCH_MAX_PALLETS) &&
+               chooseKeyWidth(instance.pallets, instance.capacity) == KeyWidth::Bits32;
+    }
+
+    /**
+     * @brief DP buffers reused by every instance a thread solves.
+     */
+    struct BatchBuffers {
+        std::vector<int32_t> prev;
+        std::vector<int32_t> curr;
+        std::vector<uint8_t> decisions; // (palete, capacidade) -> palete incluída
+    };
+
+    /**
+     * @brief Same DP as solveDynamic() with 32-bit keys, on reused buffers.
+     *
+     * @param instance Instance to solve.
+     * @param buffers Buffers of the calling thread.
+     * @param result Reference to store the solution.
+     */
+    void solveInBuffers(const TruckInstance& instance, BatchBuffers& buffers, ILPResult& result) {
+        const std::vector<Pallet>& pallets = instance.pallets;
+        int n = pallets.size();
+        int capacity = instance.capacity;
+        int columns = capacity + 1;
+        ObjectiveKey<int32_t> objective = ObjectiveKey<int32_t>::forInstance(pallets, capacity);
+
+        // assign()/resize() só realocam quando a instância é maior do que todas as anteriores
+        buffers.prev.assign(columns, objective.emptyKey());
+        buffers.curr.resize(columns);
+        buffers.decisions.resize(static_cast<size_t>(n) * columns);
+
+        const DpKernels& kernels = dpKernels();
+        for (int i = 0; i < n; ++i) {
+            kernels.relaxTaken32(buffers.prev.data(), buffers.curr.data(),
+                                 &buffers.decisions[static_cast<size_t>(i) * columns],
+                                 pallets[i].weight, capacity, objective.itemKey(pallets[i]));
+            buffers.prev.swap(buffers.curr);
+        }
+
+        // Reconstruir subconjunto ótimo (em empate exato, excluir a palete)
+        result.totalProfit = objective.profit(buffers.prev[capacity]);
+        result.totalWeight = 0;
+        result.selectedPallets.clear();
+
+        int w = capacity;
+        for (int i = n - 1; i >= 0; --i) {
+            if (buffers.decisions[static_cast<size_t>(i) * columns + w]) {
+                result.selectedPallets.push_back(pallets[i].id);
+                result.totalWeight += pallets[i].weight;
+                w -= pallets[i].weight;
+            }
+        }
+        std::reverse(result.selectedPallets.begin(), result.selectedPallets.end());
+    }
+}
+
+std::vector<ILPResult> solveDynamicBatch(const std::vector<TruckInstance>& instances) {
+    SolverWorkspace workspace;
+    return solveDynamicBatch(instances, workspace);
+}
+
+std::vector<ILPResult> solveDynamicBatch(const std::vector<TruckInstance>& instances, SolverWorkspace& workspace) {
+    std::vector<ILPResult> results(instances.size());
+
+    // As instâncias grandes partilham o workspace, em vez de uma tabela nova cada uma
+    std::vector<int> batched;
+    for (size_t idx = 0; idx < instances.size(); ++idx) {
+        if (fitsBatch(instances[idx])) batched.push_back(static_cast<int>(idx));
+        else solveDynamic(instances[idx].pallets, instances[idx].capacity, workspace, results[idx]);
+    }
+    int count = batched.size();
+
+#ifdef _OPENMP
+    #pragma omp parallel
+#endif
+    {
+        BatchBuffers buffers;
+        buffers.prev.reserve(BATCH_MAX_CAPACITY + 1);
+        buffers.curr.reserve(BATCH_MAX_CAPACITY + 1);
+        buffers.decisions.reserve(static_cast<size_t>(BATCH_MAX_PALLETS) * (BATCH_MAX_CAPACITY + 1));
+
+#ifdef _OPENMP
+        #pragma omp for schedule(dynamic, 16)
+#endif
+        for (int k = 0; k < count; ++k) {
+            solveInBuffers(instances[batched[k]], buffers, results[batched[k]]);
+        }
+    }
+
+    return results;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file batch.h
+ * @brief Dynamic programming over many small instances at once.
+ *
+ * Meant for streams of small trucks (a few dozen pallets, capacities in the
+ * hundreds): every thread solves its share of the instances on one set of
+ * DP buffers that stays in cache, instead of allocating a fresh table per
+ * solve, and the instances are spread across OpenMP threads when available.
+ *
+ * @author Luís Martins e João Taveira
+ * @date 2025-05-20
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <vector>
+#include "Pallet.h"
+#include "algorithms.h"
+
+/**
+ * @brief One independent loading problem.
+ */
+struct TruckInstance {
+    int capacity;
+    std::vector<Pallet> pallets;
+};
+
+/**
+ * @brief Largest capacity solved on the shared buffers; larger trucks use solveDynamic().
+ */
+constexpr int BATCH_MAX_CAPACITY = 1024;
+
+/**
+ * @brief Largest pallet count solved on the shared buffers; larger instances use solveDynamic().
+ */
+constexpr int BATCH_MAX_PALLETS = 64;
+
+/**
+ * @brief Solves every instance with the same result as solveDynamic().
+ *
+ * Small instances run the DP of solveDynamic() with 32-bit packed keys (see
+ * objective.h) and one decision byte per (pallet, capacity) cell, on buffers
+ * reused across the instances of a thread. Instances above
+ * BATCH_MAX_CAPACITY or BATCH_MAX_PALLETS, or whose key needs more than 32
+ * bits, are solved with solveDynamic().
+ *
+ * @param instances Instances to solve.
+ * @return One result per instance, in the same order.
+ */
+std::vector<ILPResult> solveDynamicBatch(const std::vector<TruckInstance>& instances);
+
+/**
+ * @brief solveDynamicBatch() with the large instances on a reusable workspace.
+ *
+ * The small instances keep their per-thread buffers; the ones handed to
+ * solveDynamic() use this workspace, so a program that keeps one does not
+ * allocate a new table per batch.
+ *
+ * @param instances Instances to solve.
+ * @param workspace Buffers reused across solves.
+ * @return One result per instance, in the same order.
+ */
+std::vector<ILPResult> solveDynamicBatch(const std::vector<TruckInstance>& instances, SolverWorkspace& workspace);
+
+#endif
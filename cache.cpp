@@ -0,0 +1,231 @@
+/**
+ * @file cache.cpp
+ * @brief Implementation of the content-addressed solution cache.
+ *
+ * The disk tier is a plain text file. The first line is a format header
+ * ("KSTCK-CACHE <version>"); files with another header are discarded. Each
+ * following line holds one solution: hash, capacity, solver, pallet count,
+ * weight sum, profit sum, total profit, total weight, number of selected
+ * pallets, their IDs and the sorted IDs of every pallet of the instance.
+ *
+ * @author Luís Martins e João Taveira
+ * @date 2025-05-20
+ */
+
+#include "cache.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <tuple>
+#include <utility>
+
+namespace {
+    /**
+     * @brief Mixes a 64-bit value into a running hash (splitmix64 finalizer).
+     *
+     * @param h Current hash.
+     * @param v Value to mix in.
+     * @return Updated hash.
+     */
+    uint64_t mix(uint64_t h, uint64_t v) {
+        h ^= v + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+        h ^= h >> 30;
+        h *= 0xbf58476d1ce4e5b9ULL;
+        h ^= h >> 27;
+        h *= 0x94d049bb133111ebULL;
+        h ^= h >> 31;
+        return h;
+    }
+
+    // Versão do formato: sobe sempre que muda a seleção devolvida pelos solvers
+    // (regra de desempate, ordem das paletes), para não servir cargas antigas
+    const char* const CACHE_MAGIC = "KSTCK-CACHE";
+    const int CACHE_VERSION = 2;
+
+    /**
+     * @brief Parses and validates one line of the disk tier.
+     *
+     * A line is rejected when it is truncated, selects more pallets than the
+     * instance has, selects a pallet twice or one outside the instance, or
+     * reports a weight above the capacity.
+     *
+     * @param line Text of the line.
+     * @param key Output key.
+     * @param result Output solution.
+     * @param palletIds Output sorted IDs of the instance.
+     * @return true if the line is valid.
+     */
+    bool parseLine(const std::string& line, CacheKey& key, ILPResult& result, std::vector<int>& palletIds) {
+        std::stringstream ss(line);
+        long long selected = 0;
+        if (!(ss >> key.hash >> key.capacity >> key.solver >> key.numPallets >> key.weightSum
+                 >> key.profitSum >> result.totalProfit >> result.totalWeight >> selected)) {
+            return false;
+        }
+
+        // Cada ID ocupa pelo menos dois carateres, o que limita os tamanhos antes de reservar memória
+        long long maxIds = static_cast<long long>(line.size()) / 2;
+        if (key.numPallets < 0 || key.numPallets > maxIds || selected < 0 || selected > key.numPallets) {
+            return false;
+        }
+        if (result.totalWeight < 0 || result.totalWeight > key.capacity) return false;
+
+        result.selectedPallets.resize(selected);
+        for (int& id : result.selectedPallets) {
+            if (!(ss >> id)) return false;
+        }
+        palletIds.resize(key.numPallets);
+        for (int& id : palletIds) {
+            if (!(ss >> id)) return false;
+        }
+        if (!std::is_sorted(palletIds.begin(), palletIds.end())) return false;
+
+        std::vector<int> chosen = result.selectedPallets;
+        std::sort(chosen.begin(), chosen.end());
+        if (std::adjacent_find(chosen.begin(), chosen.end()) != chosen.end()) return false;
+        return std::includes(palletIds.begin(), palletIds.end(), chosen.begin(), chosen.end());
+    }
+}
+
+SolutionCache::SolutionCache(size_t maxEntries, const std::string& diskPath)
+    : maxEntries(std::max<size_t>(maxEntries, 1)), diskPath(diskPath) {
+    if (!diskPath.empty()) loadFromDisk();
+}
+
+CacheKey SolutionCache::makeKey(const std::vector<Pallet>& pallets, int capacity, int solver) {
+    std::vector<Pallet> sorted = pallets;
+    std::sort(sorted.begin(), sorted.end(), [](const Pallet& a, const Pallet& b) {
+        return std::tie(a.id, a.weight, a.profit) < std::tie(b.id, b.weight, b.profit);
+    });
+
+    CacheKey key{0, capacity, solver, static_cast<int>(pallets.size()), 0, 0};
+    uint64_t h = mix(static_cast<uint64_t>(capacity), static_cast<uint64_t>(solver));
+    for (const auto& p : sorted) {
+        uint64_t packed = (static_cast<uint64_t>(static_cast<uint32_t>(p.id)) << 32) |
+                          static_cast<uint32_t>(p.weight);
+        h = mix(h, packed);
+        h = mix(h, static_cast<uint32_t>(p.profit));
+        key.weightSum += p.weight;
+        key.profitSum += p.profit;
+    }
+    key.hash = h;
+    return key;
+}
+
+bool SolutionCache::lookup(const CacheKey& key, ILPResult& result) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+        ++misses;
+        return false;
+    }
+
+    // Mover para a frente da lista (mais recentemente usado)
+    entries.splice(entries.begin(), entries, it->second);
+    result = it->second->result;
+    ++hits;
+    return true;
+}
+
+void SolutionCache::store(const CacheKey& key, const ILPResult& result, const std::vector<Pallet>& pallets) {
+    std::vector<int> ids;
+    ids.reserve(pallets.size());
+    for (const auto& p : pallets) ids.push_back(p.id);
+    std::sort(ids.begin(), ids.end());
+
+    if (!diskPath.empty()) appendToDisk(key, result, ids);
+    insert(key, result, std::move(ids));
+}
+
+void SolutionCache::appendToDisk(const CacheKey& key, const ILPResult& result, const std::vector<int>& palletIds) {
+    std::ofstream file(diskPath, std::ios::app);
+    if (!file.is_open()) return;
+
+    file << key.hash << ' ' << key.capacity << ' ' << key.solver << ' ' << key.numPallets << ' '
+         << key.weightSum << ' ' << key.profitSum << ' ' << result.totalProfit << ' '
+         << result.totalWeight << ' ' << result.selectedPallets.size();
+    for (int id : result.selectedPallets) file << ' ' << id;
+    for (int id : palletIds) file << ' ' << id;
+    file << '\n';
+}
+
+bool SolutionCache::findSimilar(const std::vector<Pallet>& pallets, int capacity, double minOverlap,
+                                ILPResult& result) const {
+    std::vector<int> ids;
+    ids.reserve(pallets.size());
+    for (const auto& p : pallets) ids.push_back(p.id);
+    std::sort(ids.begin(), ids.end());
+
+    const Entry* best = nullptr;
+    double bestOverlap = minOverlap;
+
+    for (const auto& entry : entries) {
+        if (entry.key.capacity != capacity || entry.palletIds.empty()) continue;
+
+        // Interseção de dois vetores ordenados
+        size_t common = 0;
+        auto a = ids.begin();
+        auto b = entry.palletIds.begin();
+        while (a != ids.end() && b != entry.palletIds.end()) {
+            if (*a < *b) ++a;
+            else if (*b < *a) ++b;
+            else { ++common; ++a; ++b; }
+        }
+
+        size_t united = ids.size() + entry.palletIds.size() - common;
+        double overlap = united == 0 ? 1.0 : static_cast<double>(common) / united;
+        if (overlap >= bestOverlap) {
+            bestOverlap = overlap;
+            best = &entry;
+        }
+    }
+
+    if (!best) return false;
+    result = best->result;
+    return true;
+}
+
+void SolutionCache::insert(const CacheKey& key, const ILPResult& result, std::vector<int> palletIds) {
+    auto it = index.find(key);
+    if (it != index.end()) {
+        it->second->result = result;
+        if (!palletIds.empty()) it->second->palletIds = std::move(palletIds);
+        entries.splice(entries.begin(), entries, it->second);
+        return;
+    }
+
+    entries.push_front(Entry{key, result, std::move(palletIds)});
+    index[key] = entries.begin();
+
+    if (entries.size() > maxEntries) {
+        index.erase(entries.back().key);
+        entries.pop_back();
+    }
+}
+
+void SolutionCache::loadFromDisk() {
+    bool current = false;
+    {
+        std::ifstream file(diskPath);
+        std::string line;
+        if (file.is_open() && std::getline(file, line)) {
+            std::stringstream header(line);
+            std::string magic;
+            int version = 0;
+            current = (header >> magic >> version) && magic == CACHE_MAGIC && version == CACHE_VERSION;
+        }
+
+        // Linhas mais recentes substituem as antigas; linhas truncadas ou inválidas são ignoradas
+        while (current && std::getline(file, line)) {
+            CacheKey key{};
+            ILPResult result{};
+            std::vector<int> palletIds;
+            if (parseLine(line, key, result, palletIds)) insert(key, result, std::move(palletIds));
+        }
+    }
+
+    // Ficheiro novo, sem cabeçalho ou de outra versão: recomeçar só com o cabeçalho
+    if (!current) {
+        std::ofstream file(diskPath, std::ios::trunc);
+        if (file.is_open()) file << CACHE_MAGIC << ' ' << CACHE_VERSION << '\n';
+    }
+}
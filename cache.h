@@ -0,0 +1,155 @@
+/**
+ * @file cache.h
+ * @brief Content-addressed cache of previously solved knapsack instances.
+ *
+ * Instances are identified by a hash of the canonicalized pallet multiset,
+ * the truck capacity and the solver used. Results live in an in-memory LRU
+ * tier and, optionally, in an append-only file that survives restarts.
+ *
+ * @author Luís Martins e João Taveira
+ * @date 2025-05-20
+ */
+
+#ifndef CACHE_H
+#define CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Pallet.h"
+#include "algorithms.h"
+
+/**
+ * @brief Key identifying one solved instance.
+ *
+ * Besides the hash, the pallet count and weight/profit sums are kept as a
+ * cheap guard against hash collisions.
+ */
+struct CacheKey {
+    uint64_t hash;
+    int capacity;
+    int solver;
+    int numPallets;
+    long long weightSum;
+    long long profitSum;
+
+    bool operator==(const CacheKey& other) const {
+        return hash == other.hash && capacity == other.capacity && solver == other.solver &&
+               numPallets == other.numPallets && weightSum == other.weightSum &&
+               profitSum == other.profitSum;
+    }
+};
+
+/**
+ * @brief Hash functor for CacheKey (the key already carries a hash).
+ */
+struct CacheKeyHash {
+    size_t operator()(const CacheKey& key) const {
+        return static_cast<size_t>(key.hash ^ (static_cast<uint64_t>(key.capacity) << 17) ^ key.solver);
+    }
+};
+
+/**
+ * @brief LRU cache of knapsack solutions with an optional on-disk tier.
+ */
+class SolutionCache {
+public:
+    /**
+     * @brief Creates the cache.
+     *
+     * @param maxEntries Maximum number of entries kept in memory.
+     * @param diskPath Append-only file backing the cache, empty to disable it.
+     *        A file written by another format version is discarded.
+     */
+    explicit SolutionCache(size_t maxEntries = 256, const std::string& diskPath = "");
+
+    /**
+     * @brief Builds the key of an instance.
+     *
+     * The pallets are sorted by (ID, weight, profit) first, so the key does
+     * not depend on the order in which they were read.
+     *
+     * @param pallets Pallets of the instance.
+     * @param capacity Truck capacity.
+     * @param solver Identifier of the solver (menu option number).
+     * @return Key of the instance.
+     */
+    static CacheKey makeKey(const std::vector<Pallet>& pallets, int capacity, int solver);
+
+    /**
+     * @brief Looks up a previously stored solution.
+     *
+     * @param key Key returned by makeKey().
+     * @param result Reference to store the cached solution.
+     * @return true on a cache hit, false otherwise.
+     */
+    bool lookup(const CacheKey& key, ILPResult& result);
+
+    /**
+     * @brief Stores a solution, appending it to the disk tier if enabled.
+     *
+     * The pallet IDs of the instance are kept in memory so the entry can
+     * later be used as a warm start by findSimilar().
+     *
+     * @param key Key returned by makeKey().
+     * @param result Solution to store.
+     * @param pallets Pallets of the solved instance.
+     */
+    void store(const CacheKey& key, const ILPResult& result, const std::vector<Pallet>& pallets);
+
+    /**
+     * @brief Finds the most similar solved instance with the same capacity.
+     *
+     * Similarity is the Jaccard overlap between the pallet ID sets.
+     *
+     * @param pallets Pallets of the new instance.
+     * @param capacity Truck capacity.
+     * @param minOverlap Minimum Jaccard overlap accepted (0 to 1).
+     * @param result Reference to store the solution of the similar instance.
+     * @return true if an instance with enough overlap was found.
+     */
+    bool findSimilar(const std::vector<Pallet>& pallets, int capacity, double minOverlap, ILPResult& result) const;
+
+    /**
+     * @brief Returns the number of entries held in memory.
+     * @return Number of entries.
+     */
+    size_t size() const { return entries.size(); }
+
+    /**
+     * @brief Returns the number of lookups that found a solution.
+     * @return Hit count.
+     */
+    size_t getHits() const { return hits; }
+
+    /**
+     * @brief Returns the number of lookups that missed.
+     * @return Miss count.
+     */
+    size_t getMisses() const { return misses; }
+
+private:
+    /**
+     * @brief One cached solution and the sorted pallet IDs of its instance.
+     */
+    struct Entry {
+        CacheKey key;
+        ILPResult result;
+        std::vector<int> palletIds;
+    };
+
+    void insert(const CacheKey& key, const ILPResult& result, std::vector<int> palletIds);
+    void loadFromDisk();
+    void appendToDisk(const CacheKey& key, const ILPResult& result, const std::vector<int>& palletIds);
+
+    size_t maxEntries;
+    std::string diskPath;
+    std::list<Entry> entries; // mais recente à frente
+    std::unordered_map<CacheKey, std::list<Entry>::iterator, CacheKeyHash> index;
+    size_t hits = 0;
+    size_t misses = 0;
+};
+
+#endif
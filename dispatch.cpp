@@ -0,0 +1,179 @@
+/**
+ * @file dispatch.cpp
+ * @brief Kernel variants per instruction set level and their selection.
+ *
+ * Each kernel body is written once as a template and instantiated inside
+ * wrappers carrying GCC/Clang target attributes, so the compiler vectorizes
+ * the same loop for every level without raising the baseline flags of the
+ * rest of the program. The vectorizer options themselves (GCC's -O2 cost
+ * model skips loops with a remainder) are set for this file alone in
+ * CMakeLists.txt.
+ *
+ * @author Luís Martins e João Taveira
+ * @date 2025-05-20
+ */
+
+#include "dispatch.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define KNAPSACK_X86_DISPATCH 1
+#define KNAPSACK_INLINE inline __attribute__((always_inline))
+#else
+#define KNAPSACK_X86_DISPATCH 0
+#define KNAPSACK_INLINE inline
+#endif
+
+namespace {
+    template <typename Key>
+    KNAPSACK_INLINE void relaxBody(const Key* __restrict prev, Key* __restrict curr, int weight, int capacity,
+                                   Key key) {
+        int split = std::min(std::max(weight, 0), capacity + 1);
+        for (int w = 0; w < split; ++w) curr[w] = prev[w];
+        for (int w = split; w <= capacity; ++w) curr[w] = std::max(prev[w], prev[w - weight] + key);
+    }
+
+    template <typename Key>
+    KNAPSACK_INLINE void relaxSegmentBody(const Key* __restrict stay, const Key* __restrict shifted,
+                                          Key* __restrict out, int count, Key key) {
+        for (int j = 0; j < count; ++j) out[j] = std::max(stay[j], shifted[j] + key);
+    }
+
+    KNAPSACK_INLINE void relaxTakenBody(const int32_t* __restrict prev, int32_t* __restrict curr,
+                                        uint8_t* __restrict taken, int weight, int capacity, int32_t key) {
+        int split = std::min(std::max(weight, 0), capacity + 1);
+        for (int w = 0; w < split; ++w) {
+            curr[w] = prev[w];
+            taken[w] = 0;
+        }
+        for (int w = split; w <= capacity; ++w) {
+            int32_t candidate = prev[w - weight] + key;
+            bool better = candidate > prev[w];
+            curr[w] = better ? candidate : prev[w];
+            taken[w] = better;
+        }
+    }
+
+    template <typename Key>
+    KNAPSACK_INLINE Key bestSplitBody(const Key* before, const Key* after, int capacity) {
+        Key best = before[0] + after[capacity];
+        for (int w = 1; w <= capacity; ++w) best = std::max(best, before[w] + after[capacity - w]);
+        return best;
+    }
+}
+
+// Um conjunto de kernels por nível: o mesmo corpo compilado com outro target
+#define KNAPSACK_KERNELS(SUFFIX, ATTRIBUTES)                                                                  \
+    namespace {                                                                                               \
+        ATTRIBUTES void relax32##SUFFIX(const int32_t* prev, int32_t* curr, int weight, int capacity,         \
+                                        int32_t key) {                                                        \
+            relaxBody<int32_t>(prev, curr, weight, capacity, key);                                            \
+        }                                                                                                     \
+        ATTRIBUTES void relax64##SUFFIX(const int64_t* prev, int64_t* curr, int weight, int capacity,         \
+                                        int64_t key) {                                                        \
+            relaxBody<int64_t>(prev, curr, weight, capacity, key);                                            \
+        }                                                                                                     \
+        ATTRIBUTES void relaxTaken32##SUFFIX(const int32_t* prev, int32_t* curr, uint8_t* taken,              \
+                                             int weight, int capacity, int32_t key) {                         \
+            relaxTakenBody(prev, curr, taken, weight, capacity, key);                                         \
+        }                                                                                                     \
+        ATTRIBUTES void relaxSegment32##SUFFIX(const int32_t* stay, const int32_t* shifted, int32_t* out,     \
+                                               int count, int32_t key) {                                      \
+            relaxSegmentBody<int32_t>(stay, shifted, out, count, key);                                        \
+        }                                                                                                     \
+        ATTRIBUTES void relaxSegment64##SUFFIX(const int64_t* stay, const int64_t* shifted, int64_t* out,     \
+                                               int count, int64_t key) {                                      \
+            relaxSegmentBody<int64_t>(stay, shifted, out, count, key);                                        \
+        }                                                                                                     \
+        ATTRIBUTES int32_t bestSplit32##SUFFIX(const int32_t* before, const int32_t* after, int capacity) {   \
+            return bestSplitBody<int32_t>(before, after, capacity);                                           \
+        }                                                                                                     \
+        ATTRIBUTES int64_t bestSplit64##SUFFIX(const int64_t* before, const int64_t* after, int capacity) {   \
+            return bestSplitBody<int64_t>(before, after, capacity);                                           \
+        }                                                                                                     \
+    }
+
+KNAPSACK_KERNELS(Generic, )
+
+#if KNAPSACK_X86_DISPATCH
+KNAPSACK_KERNELS(SSE42, __attribute__((target("sse4.2"))))
+KNAPSACK_KERNELS(AVX2, __attribute__((target("avx2"))))
+KNAPSACK_KERNELS(AVX512, __attribute__((target("avx512f,avx512bw"))))
+#endif
+
+namespace {
+    const DpKernels GENERIC_KERNELS{CpuLevel::Generic, relax32Generic, relax64Generic, relaxTaken32Generic,
+                                    relaxSegment32Generic, relaxSegment64Generic, bestSplit32Generic, bestSplit64Generic};
+#if KNAPSACK_X86_DISPATCH
+    const DpKernels SSE42_KERNELS{CpuLevel::SSE42, relax32SSE42, relax64SSE42, relaxTaken32SSE42,
+                                  relaxSegment32SSE42, relaxSegment64SSE42, bestSplit32SSE42, bestSplit64SSE42};
+    const DpKernels AVX2_KERNELS{CpuLevel::AVX2, relax32AVX2, relax64AVX2, relaxTaken32AVX2,
+                                 relaxSegment32AVX2, relaxSegment64AVX2, bestSplit32AVX2, bestSplit64AVX2};
+    const DpKernels AVX512_KERNELS{CpuLevel::AVX512, relax32AVX512, relax64AVX512, relaxTaken32AVX512,
+                                   relaxSegment32AVX512, relaxSegment64AVX512, bestSplit32AVX512, bestSplit64AVX512};
+#endif
+
+    /**
+     * @brief Parses the KNAPSACK_CPU override.
+     *
+     * @param fallback Level returned when the variable is unset or unknown.
+     * @return Requested level.
+     */
+    CpuLevel requestedCpuLevel(CpuLevel fallback) {
+        const char* value = std::getenv("KNAPSACK_CPU");
+        if (!value) return fallback;
+        if (std::strcmp(value, "generic") == 0) return CpuLevel::Generic;
+        if (std::strcmp(value, "sse4.2") == 0) return CpuLevel::SSE42;
+        if (std::strcmp(value, "avx2") == 0) return CpuLevel::AVX2;
+        if (std::strcmp(value, "avx512") == 0) return CpuLevel::AVX512;
+        return fallback;
+    }
+}
+
+CpuLevel detectCpuLevel() {
+#if KNAPSACK_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) return CpuLevel::AVX512;
+    if (__builtin_cpu_supports("avx2")) return CpuLevel::AVX2;
+    if (__builtin_cpu_supports("sse4.2")) return CpuLevel::SSE42;
+#endif
+    return CpuLevel::Generic;
+}
+
+CpuLevel activeCpuLevel() {
+    static const CpuLevel level = [] {
+        CpuLevel detected = detectCpuLevel();
+        return std::min(detected, requestedCpuLevel(detected));
+    }();
+    return level;
+}
+
+const DpKernels& dpKernelsFor(CpuLevel level) {
+#if KNAPSACK_X86_DISPATCH
+    switch (level) {
+        case CpuLevel::AVX512: return AVX512_KERNELS;
+        case CpuLevel::AVX2: return AVX2_KERNELS;
+        case CpuLevel::SSE42: return SSE42_KERNELS;
+        default: break;
+    }
+#else
+    (void)level;
+#endif
+    return GENERIC_KERNELS;
+}
+
+const DpKernels& dpKernels() {
+    static const DpKernels& kernels = dpKernelsFor(activeCpuLevel());
+    return kernels;
+}
+
+const char* cpuLevelName(CpuLevel level) {
+    switch (level) {
+        case CpuLevel::SSE42: return "sse4.2";
+        case CpuLevel::AVX2: return "avx2";
+        case CpuLevel::AVX512: return "avx512";
+        default: return "generic";
+    }
+}
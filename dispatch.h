@@ -0,0 +1,96 @@
+/**
+ * @file dispatch.h
+ * @brief Runtime selection of the vectorized DP kernels.
+ *
+ * The inner loops shared by the DP solvers are compiled once per x86
+ * instruction set level (generic, SSE4.2, AVX2, AVX-512) and the best one
+ * the CPU supports is chosen on first use, so a single binary runs the
+ * widest kernels on every machine. The environment variable KNAPSACK_CPU
+ * (generic, sse4.2, avx2 or avx512) caps the level, for benchmarking one
+ * level against another; it never raises the level above what the CPU
+ * supports.
+ *
+ * @author Luís Martins e João Taveira
+ * @date 2025-05-20
+ */
+
+#ifndef DISPATCH_H
+#define DISPATCH_H
+
+#include <cstdint>
+
+/**
+ * @brief Instruction set levels with a compiled kernel variant.
+ */
+enum class CpuLevel { Generic, SSE42, AVX2, AVX512 };
+
+/**
+ * @brief Kernels of one instruction set level.
+ *
+ * Every relax kernel computes one 0/1 knapsack row for capacities
+ * 0..capacity: curr[w] = max(prev[w], prev[w - weight] + key), with
+ * curr[w] = prev[w] when the pallet does not fit. prev and curr must not
+ * overlap.
+ */
+struct DpKernels {
+    CpuLevel level;
+
+    void (*relax32)(const int32_t* prev, int32_t* curr, int weight, int capacity, int32_t key);
+    void (*relax64)(const int64_t* prev, int64_t* curr, int weight, int capacity, int64_t key);
+
+    /**
+     * Like relax32, also writing taken[w] = 1 where the pallet strictly
+     * improves the cell and 0 elsewhere.
+     */
+    void (*relaxTaken32)(const int32_t* prev, int32_t* curr, uint8_t* taken, int weight, int capacity,
+                         int32_t key);
+
+    /**
+     * Segment form used by blocked DPs whose rows are not one array:
+     * out[j] = max(stay[j], shifted[j] + key) for j in [0, count).
+     */
+    void (*relaxSegment32)(const int32_t* stay, const int32_t* shifted, int32_t* out, int count, int32_t key);
+    void (*relaxSegment64)(const int64_t* stay, const int64_t* shifted, int64_t* out, int count, int64_t key);
+
+    /**
+     * Best split of a capacity between two rows: max over w of
+     * before[w] + after[capacity - w].
+     */
+    int32_t (*bestSplit32)(const int32_t* before, const int32_t* after, int capacity);
+    int64_t (*bestSplit64)(const int64_t* before, const int64_t* after, int capacity);
+};
+
+/**
+ * @brief Highest level supported by the CPU running the program.
+ * @return Detected level (Generic on non-x86 builds).
+ */
+CpuLevel detectCpuLevel();
+
+/**
+ * @brief Level in use: the detected one, capped by KNAPSACK_CPU if set.
+ * @return Active level (computed once).
+ */
+CpuLevel activeCpuLevel();
+
+/**
+ * @brief Kernels of the active level.
+ * @return Kernel table (selected once, on first call).
+ */
+const DpKernels& dpKernels();
+
+/**
+ * @brief Kernels of a given level, for benchmarks and tests.
+ *
+ * @param level Level; must not exceed detectCpuLevel().
+ * @return Kernel table.
+ */
+const DpKernels& dpKernelsFor(CpuLevel level);
+
+/**
+ * @brief Human readable name of a level.
+ * @param level Level.
+ * @return Name as accepted by KNAPSACK_CPU.
+ */
+const char* cpuLevelName(CpuLevel level);
+
+#endif
@@ -0,0 +1,123 @@
+/**
+ * @file dp_storage.cpp
+ * @brief Implementation of the aligned DP blocks and their huge page reports.
+ *
+ * @author Luís Martins e João Taveira
+ * @date 2025-05-20
+ */
+
+#include "dp_storage.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace {
+    constexpr size_t CACHE_LINE = 64;
+    constexpr size_t HUGE_PAGE = size_t(2) << 20;
+}
+
+AlignedBlock::AlignedBlock(size_t bytes) : bytes(bytes) {
+    if (bytes == 0) return;
+
+#ifdef __linux__
+    if (bytes >= HUGE_PAGE) {
+        // Reservar 2 MiB a mais e cortar as pontas, para o bloco começar numa fronteira de 2 MiB
+        size_t length = (bytes + HUGE_PAGE - 1) / HUGE_PAGE * HUGE_PAGE;
+        void* raw = mmap(nullptr, length + HUGE_PAGE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw != MAP_FAILED) {
+            uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+            uintptr_t aligned = (start + HUGE_PAGE - 1) / HUGE_PAGE * HUGE_PAGE;
+            if (aligned > start) munmap(raw, aligned - start);
+            size_t tail = start + length + HUGE_PAGE - (aligned + length);
+            if (tail > 0) munmap(reinterpret_cast<void*>(aligned + length), tail);
+
+            ptr = reinterpret_cast<void*>(aligned);
+            mapped = length;
+#ifdef MADV_HUGEPAGE
+            hugeHint = madvise(ptr, mapped, MADV_HUGEPAGE) == 0;
+#endif
+            return; // mmap anónimo já vem a zeros
+        }
+    }
+#endif
+
+    ptr = ::operator new((bytes + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE, std::align_val_t(CACHE_LINE));
+    std::memset(ptr, 0, bytes);
+}
+
+AlignedBlock::~AlignedBlock() {
+    release();
+}
+
+AlignedBlock::AlignedBlock(AlignedBlock&& other) noexcept
+    : ptr(other.ptr), bytes(other.bytes), mapped(other.mapped), hugeHint(other.hugeHint) {
+    other.ptr = nullptr;
+    other.bytes = 0;
+    other.mapped = 0;
+    other.hugeHint = false;
+}
+
+AlignedBlock& AlignedBlock::operator=(AlignedBlock&& other) noexcept {
+    if (this != &other) {
+        release();
+        std::swap(ptr, other.ptr);
+        std::swap(bytes, other.bytes);
+        std::swap(mapped, other.mapped);
+        std::swap(hugeHint, other.hugeHint);
+    }
+    return *this;
+}
+
+size_t AlignedBlock::hugePageBytes() const {
+#ifdef __linux__
+    if (!ptr || mapped == 0) return 0;
+
+    // Procurar a região de smaps que contém o bloco e ler AnonHugePages
+    std::ifstream smaps("/proc/self/smaps");
+    uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+    std::string line;
+    bool inside = false;
+    while (std::getline(smaps, line)) {
+        unsigned long long from, to;
+        char dash;
+        std::istringstream header(line);
+        if (header >> std::hex >> from >> dash >> to && dash == '-') {
+            inside = from <= address && address < to;
+            continue;
+        }
+        if (inside && line.compare(0, 14, "AnonHugePages:") == 0) {
+            size_t kb = std::stoull(line.substr(14));
+            return std::min(kb * 1024, bytes);
+        }
+    }
+#endif
+    return 0;
+}
+
+DpMemoryReport AlignedBlock::report(size_t used) const {
+    return DpMemoryReport{used, hugeHint, std::min(hugePageBytes(), used)};
+}
+
+void AlignedBlock::release() {
+    if (!ptr) return;
+
+#ifdef __linux__
+    if (mapped > 0) {
+        munmap(ptr, mapped);
+        ptr = nullptr;
+        return;
+    }
+#endif
+
+    ::operator delete(ptr, std::align_val_t(CACHE_LINE));
+    ptr = nullptr;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file dp_storage.h
+ * @brief Contiguous, cache-line aligned storage for DP tables.
+ *
+ * A table of n+1 separately allocated rows scatters its cells over the heap
+ * and gives no alignment guarantee to the vector kernels. DpMatrix keeps
+ * every row in one block instead, with each row starting on a 64-byte
+ * boundary. On Linux, blocks of 2 MiB or more are mapped on a 2 MiB
+ * boundary and marked with madvise(MADV_HUGEPAGE), so long row sweeps touch
+ * far fewer TLB entries when transparent huge pages are available.
+ *
+ * @author Luís Martins e João Taveira
+ * @date 2025-05-20
+ */
+
+#ifndef DP_STORAGE_H
+#define DP_STORAGE_H
+
+#include <cstddef>
+#include <type_traits>
+
+/**
+ * @brief Memory of the DP table of one solve.
+ */
+struct DpMemoryReport {
+    size_t bytes;              // tamanho da tabela (0 se o solve não usou tabela)
+    bool hugePagesRequested;   // madvise(MADV_HUGEPAGE) aceite
+    size_t hugePageBytes;      // bytes efetivamente em huge pages (AnonHugePages)
+};
+
+/**
+ * @brief Owning, zero-initialized, 64-byte aligned block of memory.
+ */
+class AlignedBlock {
+public:
+    /**
+     * @brief Allocates a block.
+     * @param bytes Size in bytes (0 allowed).
+     */
+    explicit AlignedBlock(size_t bytes = 0);
+    ~AlignedBlock();
+
+    AlignedBlock(AlignedBlock&& other) noexcept;
+    AlignedBlock& operator=(AlignedBlock&& other) noexcept;
+    AlignedBlock(const AlignedBlock&) = delete;
+    AlignedBlock& operator=(const AlignedBlock&) = delete;
+
+    void* data() const { return ptr; }
+    size_t size() const { return bytes; }
+
+    /**
+     * @brief Whether the block was mapped with a huge page hint.
+     * @return true if madvise(MADV_HUGEPAGE) succeeded.
+     */
+    bool hugePagesRequested() const { return hugeHint; }
+
+    /**
+     * @brief Bytes of the block currently backed by huge pages.
+     *
+     * Used by report(), see there for its cost.
+     *
+     * @return Bytes in huge pages (0 when unknown or not supported).
+     */
+    size_t hugePageBytes() const;
+
+    /**
+     * @brief Reports the first bytes of the block as a DP table.
+     *
+     * Reads /proc/self/smaps; only call it when the report is wanted.
+     *
+     * @param used Bytes of the block the table occupies.
+     * @return Report, with the huge page bytes capped at used.
+     */
+    DpMemoryReport report(size_t used) const;
+
+private:
+    void release();
+
+    void* ptr = nullptr;
+    size_t bytes = 0;
+    size_t mapped = 0;     // > 0 quando o bloco veio de mmap
+    bool hugeHint = false;
+};
+
+/**
+ * @brief Row-major DP table in one aligned block.
+ *
+ * Every row is padded to a multiple of 64 bytes, so row(i) is always
+ * cache-line aligned. Cells start at zero.
+ *
+ * @tparam T Trivially copyable cell type.
+ */
+template <typename T>
+class DpMatrix {
+    static_assert(std::is_trivially_copyable<T>::value, "DP cells are copied as raw memory");
+    static_assert(64 % sizeof(T) == 0, "rows are padded to whole cache lines");
+
+public:
+    /**
+     * @brief Allocates a zeroed table.
+     * @param rows Number of rows.
+     * @param cols Number of cells per row.
+     */
+    DpMatrix(size_t rows, size_t cols)
+        : rowCount(rows), colCount(cols),
+          rowStride((cols * sizeof(T) + 63) / 64 * 64 / sizeof(T)),
+          block(rows * ((cols * sizeof(T) + 63) / 64 * 64)) {}
+
+    T* row(size_t i) { return static_cast<T*>(block.data()) + i * rowStride; }
+    const T* row(size_t i) const { return static_cast<const T*>(block.data()) + i * rowStride; }
+
+    T& operator()(size_t i, size_t j) { return row(i)[j]; }
+    const T& operator()(size_t i, size_t j) const { return row(i)[j]; }
+
+    size_t rows() const { return rowCount; }
+    size_t cols() const { return colCount; }
+
+    /**
+     * @brief Underlying block, for memory reports.
+     * @return Block.
+     */
+    const AlignedBlock& storage() const { return block; }
+
+private:
+    size_t rowCount;
+    size_t colCount;
+    size_t rowStride;
+    AlignedBlock block;
+};
+
+#endif
@@ -0,0 +1,138 @@
+/**
+ * @file efficiency.h
+ * @brief Efficiency order and LP (Dantzig) bound shared by the exact solvers.
+ *
+ * The branch and bound, the preprocessing reductions, the small-instance
+ * solvers and the dynamic greedy estimate all rank pallets by decreasing
+ * profit/weight ratio and bound loads with the fractional relaxation over
+ * that order. Ratios are compared by cross-multiplication, without
+ * divisions, and pallets without weight come first (0/0 has no ratio).
+ *
+ * @author Luís Martins e João Taveira
+ * @date 2025-05-20
+ */
+
+#ifndef EFFICIENCY_H
+#define EFFICIENCY_H
+
+#include <algorithm>
+#include <vector>
+#include "Pallet.h"
+
+/**
+ * @brief Compares the profit/weight ratio of two pallets.
+ *
+ * @param a First pallet.
+ * @param b Second pallet.
+ * @return Negative if a is more efficient, positive if b is, 0 on a tie.
+ */
+inline int compareEfficiency(const Pallet& a, const Pallet& b) {
+    // Paletes sem peso primeiro (0/0 não tem ordem definida)
+    bool freeA = a.weight == 0;
+    bool freeB = b.weight == 0;
+    if (freeA || freeB) return freeA == freeB ? 0 : (freeA ? -1 : 1);
+
+    long long left = static_cast<long long>(a.profit) * b.weight;
+    long long right = static_cast<long long>(b.profit) * a.weight;
+    return left > right ? -1 : (left < right ? 1 : 0);
+}
+
+/**
+ * @brief Computes the input indices of the pallets by decreasing profit/weight ratio.
+ *
+ * Pallets with the same ratio keep their input order. The index is the
+ * last comparison key instead of using std::stable_sort, which allocates
+ * a temporary buffer.
+ *
+ * @param pallets List of pallets.
+ * @param order Output input indices in efficiency order (its storage is reused).
+ */
+inline void efficiencyOrder(const std::vector<Pallet>& pallets, std::vector<int>& order) {
+    order.resize(pallets.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = static_cast<int>(i);
+    std::sort(order.begin(), order.end(), [&pallets](int a, int b) {
+        int cmp = compareEfficiency(pallets[a], pallets[b]);
+        return cmp != 0 ? cmp < 0 : a < b;
+    });
+}
+
+/**
+ * @brief Dantzig bounds over pallets sorted by efficiency.
+ *
+ * The prefix sums live in caller-owned vectors, so a solver can keep them
+ * in its workspace and reuse their storage across solves.
+ */
+struct LPBound {
+    const std::vector<Pallet>& sorted;
+    std::vector<long long>& prefWeight;
+    std::vector<long long>& prefProfit;
+
+    /**
+     * @brief Builds the prefix sums.
+     * @param sorted Pallets sorted by decreasing profit/weight ratio.
+     * @param prefWeight Storage for the weight prefix sums.
+     * @param prefProfit Storage for the profit prefix sums.
+     */
+    LPBound(const std::vector<Pallet>& sorted, std::vector<long long>& prefWeight,
+            std::vector<long long>& prefProfit)
+        : sorted(sorted), prefWeight(prefWeight), prefProfit(prefProfit) {
+        prefWeight.assign(sorted.size() + 1, 0);
+        prefProfit.assign(sorted.size() + 1, 0);
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            prefWeight[i + 1] = prefWeight[i] + sorted[i].weight;
+            prefProfit[i + 1] = prefProfit[i] + sorted[i].profit;
+        }
+    }
+
+    /**
+     * @brief Fractional bound on the profit of pallets idx..n-1.
+     *
+     * @param idx First pallet still undecided.
+     * @param remaining Remaining capacity.
+     * @return Integer upper bound (floor of the LP optimum).
+     */
+    long long upperBound(int idx, long long remaining) const {
+        long long limit = prefWeight[idx] + remaining;
+        int j = static_cast<int>(std::upper_bound(prefWeight.begin() + idx + 1, prefWeight.end(), limit)
+                                 - prefWeight.begin()) - 1;
+        long long bound = prefProfit[j] - prefProfit[idx];
+        if (j < static_cast<int>(sorted.size())) {
+            bound += (limit - prefWeight[j]) * sorted[j].profit / sorted[j].weight;
+        }
+        return bound;
+    }
+
+    /**
+     * @brief Fractional bound on the profit of every pallet except one.
+     *
+     * Position m of the sequence without the pallet maps to sorted
+     * position m (before it) or m + 1 (after it), so its prefix sums are
+     * the full ones minus the skipped pallet once it has been passed.
+     *
+     * @param skip Sorted position of the pallet left out.
+     * @param capacity Capacity available.
+     * @return Integer upper bound (floor of the LP optimum).
+     */
+    long long without(int skip, long long capacity) const {
+        int n = static_cast<int>(sorted.size()) - 1;
+        auto weightOf = [&](int m) { return m <= skip ? prefWeight[m] : prefWeight[m + 1] - sorted[skip].weight; };
+        auto profitOf = [&](int m) { return m <= skip ? prefProfit[m] : prefProfit[m + 1] - sorted[skip].profit; };
+
+        // Maior prefixo que cabe (os prefixos são monótonos)
+        int lo = 0, hi = n;
+        while (lo < hi) {
+            int mid = (lo + hi + 1) / 2;
+            if (weightOf(mid) <= capacity) lo = mid;
+            else hi = mid - 1;
+        }
+
+        long long bound = profitOf(lo);
+        if (lo < n) {
+            const Pallet& critical = sorted[lo < skip ? lo : lo + 1];
+            bound += (capacity - weightOf(lo)) * critical.profit / critical.weight;
+        }
+        return bound;
+    }
+};
+
+#endif
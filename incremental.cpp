@@ -0,0 +1,374 @@
+/**
+ * @file incremental.cpp
+ * @brief Implementation of the incremental knapsack solvers.
+ *
+ * @author Luís Martins e João Taveira
+ * @date 2025-05-20
+ */
+
+#include "incremental.h"
+#include "efficiency.h"
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+IncrementalKnapsack::IncrementalKnapsack(int capacity)
+    : capacity(std::max(capacity, 0)),
+      words((static_cast<size_t>(std::max(capacity, 0)) + 64) / 64),
+      row(std::max(capacity, 0) + 1, 0) {}
+
+void IncrementalKnapsack::addPallet(const Pallet& pallet) {
+    size_t base = decisions.size();
+    decisions.resize(base + words, 0);
+    pallets.push_back(pallet);
+
+    int peso = pallet.weight;
+    long long lucro = pallet.profit;
+
+    // Linha única percorrida de trás para a frente: row[w - peso] ainda é a linha anterior
+    for (int w = capacity; w >= peso; --w) {
+        long long inclui = row[w - peso] + lucro;
+        if (inclui > row[w]) {
+            row[w] = inclui;
+            decisions[base + w / 64] |= uint64_t(1) << (w % 64);
+        }
+    }
+}
+
+void IncrementalKnapsack::addPallets(const std::vector<Pallet>& newPallets) {
+    decisions.reserve(decisions.size() + newPallets.size() * words);
+    for (const auto& p : newPallets) addPallet(p);
+}
+
+ILPResult IncrementalKnapsack::getResult(int atCapacity) const {
+    int w = std::min(std::max(atCapacity, 0), capacity);
+
+    ILPResult result;
+    result.totalProfit = row[w];
+    result.totalWeight = 0;
+
+    for (int i = static_cast<int>(pallets.size()) - 1; i >= 0; --i) {
+        if (decisions[i * words + w / 64] >> (w % 64) & 1) {
+            result.selectedPallets.push_back(pallets[i].id);
+            result.totalWeight += pallets[i].weight;
+            w -= pallets[i].weight;
+        }
+    }
+
+    std::reverse(result.selectedPallets.begin(), result.selectedPallets.end());
+    return result;
+}
+
+SlidingWindowKnapsack::SlidingWindowKnapsack(int capacity)
+    : capacity(std::max(capacity, 0)), emptyRow(std::max(capacity, 0) + 1, 0) {}
+
+void SlidingWindowKnapsack::pushOnto(std::vector<StackEntry>& stack, const Pallet& pallet) {
+    std::vector<long long> row = topRow(stack);
+    for (int w = capacity; w >= pallet.weight; --w) {
+        row[w] = std::max<long long>(row[w], row[w - pallet.weight] + pallet.profit);
+    }
+    stack.push_back(StackEntry{pallet, std::move(row)});
+}
+
+const std::vector<long long>& SlidingWindowKnapsack::topRow(const std::vector<StackEntry>& stack) const {
+    return stack.empty() ? emptyRow : stack.back().row;
+}
+
+void SlidingWindowKnapsack::push(const Pallet& pallet) {
+    pushOnto(back, pallet);
+}
+
+bool SlidingWindowKnapsack::pop() {
+    if (front.empty()) {
+        if (back.empty()) return false;
+
+        // Passar a pilha de trás para a da frente, recalculando as linhas
+        std::vector<StackEntry> moved;
+        moved.swap(back);
+        for (auto it = moved.rbegin(); it != moved.rend(); ++it) {
+            pushOnto(front, it->pallet);
+        }
+    }
+    front.pop_back();
+    return true;
+}
+
+int SlidingWindowKnapsack::bestSplit() const {
+    const std::vector<long long>& f = topRow(front);
+    const std::vector<long long>& b = topRow(back);
+
+    // As linhas são "melhor lucro com peso <= w", logo basta dividir a capacidade
+    int bestW = 0;
+    long long best = f[0] + b[capacity];
+    for (int w = 1; w <= capacity; ++w) {
+        long long value = f[w] + b[capacity - w];
+        if (value > best) {
+            best = value;
+            bestW = w;
+        }
+    }
+    return bestW;
+}
+
+long long SlidingWindowKnapsack::getProfit() const {
+    int w = bestSplit();
+    return topRow(front)[w] + topRow(back)[capacity - w];
+}
+
+void SlidingWindowKnapsack::collect(const std::vector<StackEntry>& stack, int w, ILPResult& result) const {
+    for (int i = static_cast<int>(stack.size()) - 1; i >= 0; --i) {
+        const std::vector<long long>& below = i > 0 ? stack[i - 1].row : emptyRow;
+        if (stack[i].row[w] != below[w]) {
+            result.selectedPallets.push_back(stack[i].pallet.id);
+            result.totalWeight += stack[i].pallet.weight;
+            w -= stack[i].pallet.weight;
+        }
+    }
+}
+
+ILPResult SlidingWindowKnapsack::getResult() const {
+    ILPResult result;
+    result.totalWeight = 0;
+
+    int w = bestSplit();
+    result.totalProfit = topRow(front)[w] + topRow(back)[capacity - w];
+
+    // Pilha da frente: do topo (mais antiga) para baixo já está por ordem de chegada
+    collect(front, w, result);
+
+    // Pilha de trás: do topo (mais recente) para baixo, é preciso inverter
+    size_t split = result.selectedPallets.size();
+    collect(back, capacity - w, result);
+    std::reverse(result.selectedPallets.begin() + split, result.selectedPallets.end());
+    return result;
+}
+
+namespace {
+    /**
+     * @brief Segment tree over query indices holding the pallets alive on each node.
+     */
+    struct LifetimeTree {
+        int queries;
+        std::vector<std::vector<Pallet>> nodes;
+
+        explicit LifetimeTree(int queries) : queries(queries), nodes(4 * std::max(queries, 1)) {}
+
+        void add(int node, int lo, int hi, int l, int r, const Pallet& pallet) {
+            if (r <= lo || hi <= l) return;
+            if (l <= lo && hi <= r) {
+                nodes[node].push_back(pallet);
+                return;
+            }
+            int mid = (lo + hi) / 2;
+            add(2 * node, lo, mid, l, r, pallet);
+            add(2 * node + 1, mid, hi, l, r, pallet);
+        }
+
+        /**
+         * @brief Adds a pallet present for queries [l, r).
+         */
+        void add(int l, int r, const Pallet& pallet) {
+            if (l < r) add(1, 0, queries, l, r, pallet);
+        }
+
+        void solve(int node, int lo, int hi, int capacity, std::vector<std::vector<long long>>& rows,
+                   int depth, std::vector<long long>& answers) const {
+            // Linha do pai copiada para este nível; o nível do pai fica intacto (rollback)
+            if (static_cast<int>(rows.size()) <= depth + 1) rows.emplace_back(capacity + 1, 0);
+            std::vector<long long>& row = rows[depth + 1];
+            row = rows[depth];
+
+            for (const auto& p : nodes[node]) {
+                for (int w = capacity; w >= p.weight; --w) {
+                    row[w] = std::max<long long>(row[w], row[w - p.weight] + p.profit);
+                }
+            }
+
+            if (hi - lo == 1) {
+                answers[lo] = row[capacity];
+                return;
+            }
+            int mid = (lo + hi) / 2;
+            solve(2 * node, lo, mid, capacity, rows, depth + 1, answers);
+            solve(2 * node + 1, mid, hi, capacity, rows, depth + 1, answers);
+        }
+    };
+}
+
+std::vector<long long> solveOfflineDynamic(int capacity, const std::vector<DockEvent>& events) {
+    capacity = std::max(capacity, 0);
+
+    int queries = 0;
+    for (const auto& e : events) {
+        if (e.type == DockEvent::Type::Query) ++queries;
+    }
+    std::vector<long long> answers(queries, 0);
+    if (queries == 0) return answers;
+
+    // Intervalo de vida de cada palete, em índices de consulta
+    LifetimeTree tree(queries);
+    std::unordered_map<int, std::pair<Pallet, int>> present;
+    int q = 0;
+    for (const auto& e : events) {
+        switch (e.type) {
+            case DockEvent::Type::Arrive:
+                present.emplace(e.pallet.id, std::make_pair(e.pallet, q));
+                break;
+            case DockEvent::Type::Leave: {
+                auto it = present.find(e.pallet.id);
+                if (it != present.end()) {
+                    tree.add(it->second.second, q, it->second.first);
+                    present.erase(it);
+                }
+                break;
+            }
+            case DockEvent::Type::Query:
+                ++q;
+                break;
+        }
+    }
+    for (const auto& entry : present) {
+        tree.add(entry.second.second, queries, entry.second.first);
+    }
+
+    std::vector<std::vector<long long>> rows(1, std::vector<long long>(capacity + 1, 0));
+    tree.solve(1, 0, queries, capacity, rows, 0, answers);
+    return answers;
+}
+
+DynamicGreedy::DynamicGreedy(int capacity) : capacity(capacity) {}
+
+bool DynamicGreedy::before(const Pallet& a, const Pallet& b) {
+    // Eficiência decrescente (efficiency.h); empate pelo ID
+    int cmp = compareEfficiency(a, b);
+    return cmp != 0 ? cmp < 0 : a.id < b.id;
+}
+
+void DynamicGreedy::pull(int node) {
+    Node& n = nodes[node];
+    n.sumWeight = n.pallet.weight;
+    n.sumProfit = n.pallet.profit;
+    if (n.left >= 0) {
+        n.sumWeight += nodes[n.left].sumWeight;
+        n.sumProfit += nodes[n.left].sumProfit;
+    }
+    if (n.right >= 0) {
+        n.sumWeight += nodes[n.right].sumWeight;
+        n.sumProfit += nodes[n.right].sumProfit;
+    }
+}
+
+void DynamicGreedy::split(int node, const Pallet& key, int& left, int& right) {
+    // left: nós antes de key; right: key e seguintes
+    if (node < 0) {
+        left = right = -1;
+        return;
+    }
+    if (before(nodes[node].pallet, key)) {
+        split(nodes[node].right, key, nodes[node].right, right);
+        left = node;
+    } else {
+        split(nodes[node].left, key, left, nodes[node].left);
+        right = node;
+    }
+    pull(node);
+}
+
+int DynamicGreedy::merge(int left, int right) {
+    if (left < 0) return right;
+    if (right < 0) return left;
+    if (nodes[left].priority > nodes[right].priority) {
+        nodes[left].right = merge(nodes[left].right, right);
+        pull(left);
+        return left;
+    }
+    nodes[right].left = merge(left, nodes[right].left);
+    pull(right);
+    return right;
+}
+
+int DynamicGreedy::erase(int node, int target) {
+    if (node == target) return merge(nodes[node].left, nodes[node].right);
+    if (before(nodes[target].pallet, nodes[node].pallet)) {
+        nodes[node].left = erase(nodes[node].left, target);
+    } else {
+        nodes[node].right = erase(nodes[node].right, target);
+    }
+    pull(node);
+    return node;
+}
+
+void DynamicGreedy::add(const Pallet& pallet) {
+    remove(pallet.id);
+
+    // xorshift32 para as prioridades da treap
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+
+    int node;
+    if (!freeNodes.empty()) {
+        node = freeNodes.back();
+        freeNodes.pop_back();
+    } else {
+        node = static_cast<int>(nodes.size());
+        nodes.emplace_back();
+    }
+    nodes[node] = Node{pallet, seed, -1, -1, 0, 0};
+    pull(node);
+    byId[pallet.id] = node;
+
+    int left, right;
+    split(root, pallet, left, right);
+    root = merge(merge(left, node), right);
+}
+
+bool DynamicGreedy::remove(int id) {
+    auto it = byId.find(id);
+    if (it == byId.end()) return false;
+
+    int node = it->second;
+    root = erase(root, node);
+    freeNodes.push_back(node);
+    byId.erase(it);
+    return true;
+}
+
+bool DynamicGreedy::update(const Pallet& pallet) {
+    if (byId.find(pallet.id) == byId.end()) return false;
+    add(pallet);
+    return true;
+}
+
+GreedyEstimate DynamicGreedy::query() const {
+    GreedyEstimate estimate{0, 0, 0.0, -1};
+    long long remaining = capacity;
+
+    // Descer até à palete de rutura acumulando os prefixos
+    int node = root;
+    while (node >= 0) {
+        const Node& n = nodes[node];
+        if (n.left >= 0 && nodes[n.left].sumWeight > remaining) {
+            node = n.left;
+            continue;
+        }
+        if (n.left >= 0) {
+            remaining -= nodes[n.left].sumWeight;
+            estimate.greedyWeight += nodes[n.left].sumWeight;
+            estimate.greedyProfit += nodes[n.left].sumProfit;
+        }
+        if (n.pallet.weight > remaining) {
+            estimate.breakPallet = n.pallet.id;
+            estimate.lpBound = static_cast<double>(estimate.greedyProfit) +
+                               static_cast<double>(remaining) * n.pallet.profit / n.pallet.weight;
+            return estimate;
+        }
+        remaining -= n.pallet.weight;
+        estimate.greedyWeight += n.pallet.weight;
+        estimate.greedyProfit += n.pallet.profit;
+        node = n.right;
+    }
+
+    estimate.lpBound = static_cast<double>(estimate.greedyProfit);
+    return estimate;
+}
@@ -0,0 +1,296 @@
+/**
+ * @file incremental.h
+ * @brief Knapsack solvers that are updated as pallets arrive instead of re-solving.
+ *
+ * These reuse the row recurrence of KDynamic(): every pallet turns the DP row
+ * of the previous pallets into a new row in O(capacity).
+ *
+ * @author Luís Martins e João Taveira
+ * @date 2025-05-20
+ */
+
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include "Pallet.h"
+#include "algorithms.h"
+
+/**
+ * @brief Dynamic programming solver that accepts pallets appended over time.
+ *
+ * Keeps the last DP row plus one bit per (pallet, capacity) cell recording
+ * whether the pallet was taken, so appending k pallets costs O(k * capacity)
+ * and the selection can be rebuilt at any moment without re-solving.
+ *
+ * Rows hold profit alone, since the packed key of KDynamic() needs every
+ * pallet up front to size its fields. A pallet is only taken when it
+ * strictly improves the profit, so among equally profitable loads the one
+ * with the earliest pallets is kept, whatever its pallet count or weight.
+ * KDynamic() prefers fewer pallets, then lower weight: for {1: w1 p1,
+ * 2: w1 p1, 3: w2 p2} and capacity 2 this solver loads {1, 2}, KDynamic()
+ * loads {3}. The profit is always the same.
+ */
+class IncrementalKnapsack {
+public:
+    /**
+     * @brief Creates an empty solver.
+     * @param capacity Truck capacity.
+     */
+    explicit IncrementalKnapsack(int capacity);
+
+    /**
+     * @brief Processes one new pallet.
+     * @param pallet Pallet to append.
+     */
+    void addPallet(const Pallet& pallet);
+
+    /**
+     * @brief Processes several new pallets, in order.
+     * @param newPallets Pallets to append.
+     */
+    void addPallets(const std::vector<Pallet>& newPallets);
+
+    /**
+     * @brief Returns the optimal profit for the pallets seen so far.
+     * @return Maximum achievable profit.
+     */
+    long long getProfit() const { return row[capacity]; }
+
+    /**
+     * @brief Rebuilds the optimal selection for the pallets seen so far.
+     * @return Struct containing selected pallet IDs, profit, and total weight.
+     */
+    ILPResult getResult() const { return getResult(capacity); }
+
+    /**
+     * @brief Rebuilds the optimal selection for a smaller truck.
+     *
+     * The last row holds the optimum of every capacity up to getCapacity(),
+     * so any of them can be reconstructed from the same decision bits.
+     *
+     * @param atCapacity Capacity between 0 and getCapacity().
+     * @return Struct containing selected pallet IDs, profit, and total weight.
+     */
+    ILPResult getResult(int atCapacity) const;
+
+    /**
+     * @brief Returns the last DP row: optimal profit for every capacity 0..getCapacity().
+     * @return DP row.
+     */
+    const std::vector<long long>& getRow() const { return row; }
+
+    /**
+     * @brief Returns the number of pallets processed.
+     * @return Pallet count.
+     */
+    int size() const { return static_cast<int>(pallets.size()); }
+
+    /**
+     * @brief Returns the truck capacity.
+     * @return Capacity.
+     */
+    int getCapacity() const { return capacity; }
+
+private:
+    int capacity;
+    size_t words;                       // palavras de 64 bits por linha de decisões
+    std::vector<long long> row;         // última linha da tabela de lucro
+    std::vector<Pallet> pallets;
+    std::vector<uint64_t> decisions;    // bit (i, w) = palete i incluída para capacidade w
+};
+
+/**
+ * @brief FIFO window of pallets supporting "add newest" and "remove oldest".
+ *
+ * Implemented as a queue made of two stacks. Every stack entry stores the DP
+ * row of the pallets below it, so a push costs O(capacity), a pop is
+ * amortized O(capacity) (the back stack is moved to the front stack only
+ * when the front is empty) and a query merges the two top rows in
+ * O(capacity). Rows hold profit alone: on ties the load returned depends
+ * on how the window is split between the stacks, and may differ from
+ * KDynamic()'s with the same profit.
+ */
+class SlidingWindowKnapsack {
+public:
+    /**
+     * @brief Creates an empty window.
+     * @param capacity Truck capacity.
+     */
+    explicit SlidingWindowKnapsack(int capacity);
+
+    /**
+     * @brief Adds a pallet as the newest one in the window.
+     * @param pallet Pallet to add.
+     */
+    void push(const Pallet& pallet);
+
+    /**
+     * @brief Removes the oldest pallet from the window.
+     * @return false if the window was already empty.
+     */
+    bool pop();
+
+    /**
+     * @brief Returns the number of pallets in the window.
+     * @return Pallet count.
+     */
+    int size() const { return static_cast<int>(front.size() + back.size()); }
+
+    /**
+     * @brief Returns the optimal profit for the pallets in the window.
+     * @return Maximum achievable profit.
+     */
+    long long getProfit() const;
+
+    /**
+     * @brief Rebuilds the optimal selection for the pallets in the window.
+     * @return Struct containing selected pallet IDs (oldest first), profit, and total weight.
+     */
+    ILPResult getResult() const;
+
+private:
+    /**
+     * @brief A pallet and the DP row of it plus every pallet below it on its stack.
+     */
+    struct StackEntry {
+        Pallet pallet;
+        std::vector<long long> row;
+    };
+
+    void pushOnto(std::vector<StackEntry>& stack, const Pallet& pallet);
+    const std::vector<long long>& topRow(const std::vector<StackEntry>& stack) const;
+    int bestSplit() const;
+    void collect(const std::vector<StackEntry>& stack, int w, ILPResult& result) const;
+
+    int capacity;
+    std::vector<long long> emptyRow;
+    std::vector<StackEntry> front; // topo = palete mais antiga
+    std::vector<StackEntry> back;  // topo = palete mais recente
+};
+
+/**
+ * @brief One event of a dock replay: a pallet arrives, a pallet leaves, or
+ * the best load for the pallets currently at the dock is requested.
+ */
+struct DockEvent {
+    enum class Type { Arrive, Leave, Query };
+
+    Type type;
+    Pallet pallet; // em Leave só o ID é usado; em Query é ignorado
+};
+
+/**
+ * @brief Answers every query of a dock replay without one full solve per event.
+ *
+ * Each pallet is present for an interval of queries; the interval is stored
+ * on the O(log Q) nodes of a segment tree over the queries that cover it.
+ * A depth-first walk applies the pallets of each node to a copy of its
+ * parent's DP row (so leaving a node rolls the row back), giving
+ * O(n * capacity * log Q) in total. Arrivals of an ID already present and
+ * departures of unknown IDs are ignored.
+ *
+ * @param capacity Truck capacity.
+ * @param events Events in chronological order.
+ * @return Maximum profit at each Query event, in order.
+ */
+std::vector<long long> solveOfflineDynamic(int capacity, const std::vector<DockEvent>& events);
+
+/**
+ * @brief Greedy estimate reported by DynamicGreedy.
+ */
+struct GreedyEstimate {
+    long long greedyProfit; // lucro das paletes antes da palete de rutura
+    long long greedyWeight;
+    double lpBound;         // limite da relaxação linear (Dantzig)
+    int breakPallet;        // ID da primeira palete que não cabe, -1 se cabem todas
+};
+
+/**
+ * @brief Greedy/LP estimate maintained under pallet insertions, removals and reweights.
+ *
+ * Pallets are kept in a treap ordered by decreasing profit/weight ratio
+ * (ties by ID) whose nodes hold subtree weight and profit sums, so every
+ * update and query is O(log n) and nothing is ever re-sorted.
+ *
+ * The greedy value is the profit of the efficiency-ordered prefix that fits.
+ * Unlike KProxy() it does not keep scanning past the break pallet, since
+ * that fill step cannot be answered in logarithmic time.
+ */
+class DynamicGreedy {
+public:
+    /**
+     * @brief Creates an empty structure.
+     * @param capacity Truck capacity.
+     */
+    explicit DynamicGreedy(int capacity);
+
+    /**
+     * @brief Adds a pallet, replacing any pallet with the same ID.
+     * @param pallet Pallet to add.
+     */
+    void add(const Pallet& pallet);
+
+    /**
+     * @brief Removes a pallet.
+     * @param id ID of the pallet.
+     * @return false if no pallet with that ID exists.
+     */
+    bool remove(int id);
+
+    /**
+     * @brief Changes the weight and profit of an existing pallet.
+     * @param pallet Pallet with the new values.
+     * @return false if no pallet with that ID exists.
+     */
+    bool update(const Pallet& pallet);
+
+    /**
+     * @brief Changes the truck capacity used by query().
+     * @param newCapacity Truck capacity.
+     */
+    void setCapacity(int newCapacity) { capacity = newCapacity; }
+
+    /**
+     * @brief Computes the greedy value, LP bound and break pallet.
+     * @return Current estimate.
+     */
+    GreedyEstimate query() const;
+
+    /**
+     * @brief Returns the number of pallets held.
+     * @return Pallet count.
+     */
+    int size() const { return static_cast<int>(byId.size()); }
+
+private:
+    /**
+     * @brief Treap node with subtree sums.
+     */
+    struct Node {
+        Pallet pallet;
+        uint32_t priority;
+        int left;
+        int right;
+        long long sumWeight;
+        long long sumProfit;
+    };
+
+    static bool before(const Pallet& a, const Pallet& b);
+    void pull(int node);
+    void split(int node, const Pallet& key, int& left, int& right);
+    int merge(int left, int right);
+    int erase(int node, int target);
+
+    int capacity;
+    int root = -1;
+    uint32_t seed = 0x9e3779b9u;
+    std::vector<Node> nodes;
+    std::vector<int> freeNodes;
+    std::unordered_map<int, int> byId; // ID da palete -> nó
+};
+
+#endif
@@ -19,6 +19,13 @@
 #include "reader.h"
 #include "Pallet.h"
 #include "algorithms.h"
+#include "cache.h"
+#include "analysis.h"
+#include "batch.h"
+#include "dispatch.h"
+#include "dp_storage.h"
+#include "preprocess.h"
+#include "workspace.h"
 
 /**
  * @brief Displays the algorithm selection menu.
@@ -27,6 +34,13 @@
  */
 void showMenu();
 
+/**
+ * @brief Prints what the preprocessing removed and how much the DP table shrank.
+ *
+ * @param report Report of reduceInstance().
+ */
+void showPreprocessReport(const PreprocessReport& report);
+
 /**
  * @brief Main function to drive the knapsack algorithm selection and execution.
  *
@@ -39,6 +53,16 @@ int main() {
     std::string datasetId;
     int choice = -1;
 
+    // Soluções já calculadas (memória + ficheiro que sobrevive a reinícios)
+    SolutionCache cache(256, "solutions.cache");
+
+    // Tabelas e buffers dos solvers, reutilizados por todas as resoluções do programa
+    SolverWorkspace workspace;
+
+    // Nível de instruções vetoriais escolhido (KNAPSACK_CPU pode limitá-lo)
+    std::cout << "Vector kernels: " << cpuLevelName(activeCpuLevel())
+              << " (CPU supports " << cpuLevelName(detectCpuLevel()) << ")\n";
+
     while (choice != 0) {
         showMenu();
         std::cin >> choice;
@@ -68,7 +92,7 @@ int main() {
             continue;
         }
 
-        int result = 0;
+        long long result = 0;
         std::chrono::duration<double, std::milli> duration;
         std::string algorithmName;
 
@@ -76,23 +100,80 @@ int main() {
             case 1: {
                 algorithmName = "Brute Force";
                 auto start = std::chrono::high_resolution_clock::now();
-                result = KBruteForce(capacity, pallets);
+                PreprocessReport report;
+                ILPResult bfResult;
+                solvePreprocessed(pallets, capacity, [](const std::vector<Pallet>& reduced, int c,
+                                                        SolverWorkspace& ws, ILPResult& out) {
+                    solveBruteForce(reduced, c, ws, out);
+                }, workspace, report, bfResult);
                 auto end = std::chrono::high_resolution_clock::now();
                 duration = end - start;
+
+                showPreprocessReport(report);
+                result = bfResult.totalProfit;
+                std::cout << "Selected Pallets (ID | Value | Weight):\n";
+                for (const int& id : bfResult.selectedPallets) {
+                    auto it = std::find_if(pallets.begin(), pallets.end(), [id](const Pallet& p) {
+                        return p.id == id;
+                    });
+                    if (it != pallets.end()) {
+                        std::cout << it->id << " | " << it->profit << " | " << it->weight << "\n";
+                    }
+                }
                 break;
             }
             case 2: {
                 algorithmName = "Dynamic Programming";
                 auto start = std::chrono::high_resolution_clock::now();
-                result = KDynamic(capacity, pallets);
+                CacheKey key = SolutionCache::makeKey(pallets, capacity, choice);
+                ILPResult dpResult;
+                if (cache.lookup(key, dpResult)) {
+                    algorithmName += " (cached)";
+                } else {
+                    PreprocessReport report;
+                    DpMemoryReport memory{0, false, 0};
+                    solvePreprocessed(pallets, capacity, [&memory](const std::vector<Pallet>& reduced, int c,
+                                                                   SolverWorkspace& ws, ILPResult& out) {
+                        solveDynamic(reduced, c, ws, out, &memory);
+                    }, workspace, report, dpResult);
+                    cache.store(key, dpResult, pallets);
+                    showPreprocessReport(report);
+
+                    // Fração da tabela que a DP chegou a escrever (janelas vivas por linha)
+                    DpSweepReport sweep = lastDpSweepReport();
+                    if (!report.fitsAll && sweep.cellsTotal > 0) {
+                        std::cout << "DP cells touched: " << sweep.cellsTouched << " of " << sweep.cellsTotal << " ("
+                                  << 100.0 * sweep.cellsTouched / sweep.cellsTotal << "%)\n";
+                    }
+
+                    // Tabela desta resolução; só blocos de 2 MiB ou mais pedem huge pages
+                    if (memory.bytes > 0) {
+                        std::cout << "DP table: " << memory.bytes / 1024 << " KiB";
+                        if (memory.hugePagesRequested) {
+                            std::cout << ", huge pages: " << memory.hugePageBytes / 1024 << " KiB";
+                        }
+                        std::cout << "\n";
+                    }
+                }
                 auto end = std::chrono::high_resolution_clock::now();
                 duration = end - start;
+
+                result = dpResult.totalProfit;
+                std::cout << "Selected Pallets (ID | Value | Weight):\n";
+                for (const int& id : dpResult.selectedPallets) {
+                    auto it = std::find_if(pallets.begin(), pallets.end(), [id](const Pallet& p) {
+                        return p.id == id;
+                    });
+                    if (it != pallets.end()) {
+                        std::cout << it->id << " | " << it->profit << " | " << it->weight << "\n";
+                    }
+                }
                 break;
             }
             case 3: {
                 algorithmName = "Greedy Approximation";
                 auto start = std::chrono::high_resolution_clock::now();
-                result = KProxy(capacity, pallets);
+                result = KProxy(capacity, pallets, workspace);
                 auto end = std::chrono::high_resolution_clock::now();
                 duration = end - start;
                 break;
@@ -100,7 +181,25 @@ int main() {
             case 4: {
                 algorithmName = "Integer Linear Programming";
                 auto start = std::chrono::high_resolution_clock::now();
-                ILPResult ilpResult = solveILP(pallets, capacity);
+                CacheKey key = SolutionCache::makeKey(pallets, capacity, choice);
+                ILPResult ilpResult;
+                if (cache.lookup(key, ilpResult)) {
+                    algorithmName += " (cached)";
+                } else {
+                    // Usar a solução de uma instância parecida como ponto de partida
+                    ILPResult similar;
+                    std::vector<int> warmStart;
+                    if (cache.findSimilar(pallets, capacity, 0.8, similar)) {
+                        warmStart = similar.selectedPallets;
+                    }
+                    PreprocessReport report;
+                    solvePreprocessed(pallets, capacity, [&warmStart](const std::vector<Pallet>& reduced, int c,
+                                                                      SolverWorkspace& ws, ILPResult& out) {
+                        solveILP(reduced, c, warmStart, ws, out);
+                    }, workspace, report, ilpResult);
+                    cache.store(key, ilpResult, pallets);
+                    showPreprocessReport(report);
+                }
                 auto end = std::chrono::high_resolution_clock::now();
                 duration = end - start;
 
@@ -118,6 +217,153 @@ int main() {
 
                 break;
             }
+            case 5: {
+                algorithmName = "Capacity Profile";
+                auto start = std::chrono::high_resolution_clock::now();
+                CapacityProfile profile(pallets, capacity);
+                auto end = std::chrono::high_resolution_clock::now();
+                duration = end - start;
+
+                result = profile.profitAt(capacity);
+                std::string profileFile = "profile_" + datasetId + ".csv";
+                if (profile.saveCSV(profileFile)) {
+                    std::cout << "Profit for capacities 0.." << capacity << " saved to " << profileFile << "\n";
+                }
+
+                long long target;
+                std::cout << "Target profit: ";
+                std::cin >> target;
+                int minCapacity = profile.minCapacityFor(target);
+                if (minCapacity < 0) {
+                    std::cout << "Target not reachable with capacity " << capacity << "\n";
+                } else {
+                    std::cout << "Minimum capacity: " << minCapacity << "\n";
+                    std::cout << "Selected Pallets (ID | Value | Weight):\n";
+                    for (const int& id : profile.selectionFor(minCapacity).selectedPallets) {
+                        auto it = std::find_if(pallets.begin(), pallets.end(), [id](const Pallet& p) {
+                            return p.id == id;
+                        });
+                        if (it != pallets.end()) {
+                            std::cout << it->id << " | " << it->profit << " | " << it->weight << "\n";
+                        }
+                    }
+                }
+                break;
+            }
+            case 6: {
+                algorithmName = "Sensitivity Analysis";
+                auto start = std::chrono::high_resolution_clock::now();
+                std::vector<PalletSensitivity> analysis = sensitivityAnalysis(pallets, capacity);
+                auto end = std::chrono::high_resolution_clock::now();
+                duration = end - start;
+
+                result = 0;
+                std::cout << "Pallet | Forced in | Forced out | Marginal value\n";
+                for (const auto& s : analysis) {
+                    result = std::max<long long>({result, s.forcedIn, s.forcedOut});
+                    std::cout << s.id << " | ";
+                    if (s.forcedIn < 0) std::cout << "does not fit";
+                    else std::cout << s.forcedIn;
+                    std::cout << " | " << s.forcedOut << " | " << s.marginalValue << "\n";
+                }
+                break;
+            }
+            case 7: {
+                algorithmName = "K-Best Loads";
+                int k;
+                std::cout << "Number of loads: ";
+                std::cin >> k;
+
+                auto start = std::chrono::high_resolution_clock::now();
+                std::vector<ILPResult> loads = kBestSolutions(pallets, capacity, k);
+                auto end = std::chrono::high_resolution_clock::now();
+                duration = end - start;
+
+                result = loads.empty() ? 0 : loads.front().totalProfit;
+                for (size_t j = 0; j < loads.size(); ++j) {
+                    std::cout << "#" << j + 1 << " Profit: " << loads[j].totalProfit
+                              << " Weight: " << loads[j].totalWeight << " Pallets:";
+                    for (int id : loads[j].selectedPallets) std::cout << " " << id;
+                    std::cout << "\n";
+                }
+                break;
+            }
+            case 8: {
+                algorithmName = "Count Optimal Loads";
+                auto start = std::chrono::high_resolution_clock::now();
+                OptimalCount optimal = countOptimalSolutions(pallets, capacity);
+                auto end = std::chrono::high_resolution_clock::now();
+                duration = end - start;
+
+                result = optimal.profit;
+                if (optimal.saturated) {
+                    std::cout << "Optimal loads: more than " << toString(optimal.count)
+                              << " (" << optimal.countModulo << " mod " << optimal.modulus << ")\n";
+                } else {
+                    std::cout << "Optimal loads: " << toString(optimal.count) << "\n";
+                }
+
+                long long limit;
+                std::cout << "How many to list: ";
+                std::cin >> limit;
+                if (limit > 0) {
+                    long long listed = 0;
+                    enumerateOptimalSolutions(pallets, capacity, [&](const ILPResult& load) {
+                        std::cout << "#" << ++listed << " Weight: " << load.totalWeight << " Pallets:";
+                        for (int id : load.selectedPallets) std::cout << " " << id;
+                        std::cout << "\n";
+                        return listed < limit;
+                    });
+                }
+                break;
+            }
+            case 9: {
+                algorithmName = "Pareto Front (profit vs pallets)";
+                auto start = std::chrono::high_resolution_clock::now();
+                std::vector<ParetoPoint> front = paretoFront(pallets, capacity);
+                auto end = std::chrono::high_resolution_clock::now();
+                duration = end - start;
+
+                result = front.empty() ? 0 : front.back().profit;
+                std::cout << "Pallets | Profit | Min weight\n";
+                for (const auto& point : front) {
+                    std::cout << point.count << " | " << point.profit << " | " << point.minWeight << "\n";
+                }
+                break;
+            }
+            case 10: {
+                algorithmName = "Batch Dynamic Programming (datasets 01 to " + datasetId + ")";
+
+                // Todos os datasets até ao escolhido, resolvidos num só lote
+                std::vector<TruckInstance> instances;
+                std::vector<std::string> ids;
+                for (int d = 1; d <= std::stoi(datasetId); ++d) {
+                    std::string id = (d < 10 ? "0" : "") + std::to_string(d);
+                    TruckInstance instance;
+                    int count;
+                    if (!loadTruckData("../data/TruckAndPallets_" + id + ".csv", instance.capacity, count) ||
+                        !loadPallets("../data/Pallets_" + id + ".csv", instance.pallets)) {
+                        continue;
+                    }
+                    instances.push_back(instance);
+                    ids.push_back(id);
+                }
+
+                auto start = std::chrono::high_resolution_clock::now();
+                std::vector<ILPResult> loads = solveDynamicBatch(instances, workspace);
+                auto end = std::chrono::high_resolution_clock::now();
+                duration = end - start;
+
+                result = 0;
+                std::cout << "Dataset | Profit | Weight | Pallets\n";
+                for (size_t j = 0; j < loads.size(); ++j) {
+                    result += loads[j].totalProfit;
+                    std::cout << ids[j] << " | " << loads[j].totalProfit << " | " << loads[j].totalWeight << " |";
+                    for (int id : loads[j].selectedPallets) std::cout << " " << id;
+                    std::cout << "\n";
+                }
+                break;
+            }
             default:
                 std::cerr << "Invalid option.\n";
                 continue;
@@ -138,6 +384,34 @@ void showMenu() {
     std::cout << "  2 - Dynamic Programming\n";
     std::cout << "  3 - Approximation (Greedy Method)\n";
     std::cout << "  4 - Integer Linear Programming\n";
+    std::cout << "  5 - Capacity Profile (all truck sizes)\n";
+    std::cout << "  6 - Sensitivity Analysis (pallet forced on/off)\n";
+    std::cout << "  7 - K-Best Loads\n";
+    std::cout << "  8 - Count Optimal Loads\n";
+    std::cout << "  9 - Pareto Front (profit vs pallets)\n";
+    std::cout << " 10 - Batch Dynamic Programming (datasets 01 to N)\n";
     std::cout << "  0 - Leave\n";
     std::cout << "Option: ";
 }
+
+void showPreprocessReport(const PreprocessReport& report) {
+    auto showIds = [](const char* label, const std::vector<int>& ids) {
+        if (ids.empty()) return;
+        std::cout << "  " << label << " (" << ids.size() << "):";
+        for (int id : ids) std::cout << " " << id;
+        std::cout << "\n";
+    };
+
+    std::cout << "Preprocessing:\n";
+    showIds("Heavier than the truck", report.oversized);
+    showIds("No profit", report.zeroProfit);
+    showIds("Dominated", report.dominated);
+    showIds("Fixed in by bounds", report.fixedIn);
+    showIds("Fixed out by bounds", report.fixedOut);
+    if (report.weightScale > 1) std::cout << "  Weights and capacity divided by " << report.weightScale << "\n";
+    if (report.fitsAll) {
+        std::cout << "  All remaining pallets fit, no solver needed\n";
+    } else {
+        std::cout << "  DP table: " << report.cellsBefore << " -> " << report.cellsAfter << " cells\n";
+    }
+}
@@ -0,0 +1,160 @@
+/**
+ * @file objective.h
+ * @brief Packed lexicographic objective shared by the exact knapsack solvers.
+ *
+ * A load is ranked by maximum profit, then fewest pallets, then lowest
+ * weight. The three values are packed into one integer (32, 64 or 128 bits,
+ * whichever is the narrowest that fits the instance) so that comparing
+ * loads is a single integer comparison and adding a pallet is a single
+ * addition.
+ *
+ * @author Luís Martins e João Taveira
+ * @date 2025-05-20
+ */
+
+#ifndef OBJECTIVE_H
+#define OBJECTIVE_H
+
+#include <vector>
+#include "Pallet.h"
+
+/**
+ * @brief Number of bits needed to represent a non-negative value.
+ * @param value Value.
+ * @return Bit width (0 for 0).
+ */
+inline int bitWidth(long long value) {
+    int bits = 0;
+    while (value > 0) {
+        ++bits;
+        value >>= 1;
+    }
+    return bits;
+}
+
+/**
+ * @brief Integer widths available for the packed objective.
+ */
+enum class KeyWidth { Bits32, Bits64, Bits128 };
+
+/**
+ * @brief Bits needed by the full (profit, count, weight) key of an instance.
+ *
+ * @param pallets Pallets of the instance.
+ * @param capacity Truck capacity.
+ * @return Bits of the largest possible key, excluding the sign bit.
+ */
+inline int requiredKeyBits(const std::vector<Pallet>& pallets, int capacity) {
+    long long profitSum = 0;
+    for (const auto& p : pallets) profitSum += p.profit;
+    return bitWidth(profitSum) + bitWidth(static_cast<long long>(pallets.size())) +
+           bitWidth(capacity > 0 ? capacity : 0);
+}
+
+/**
+ * @brief Chooses the narrowest key type that holds every load of an instance.
+ *
+ * Narrow keys make DP rows denser (more cells per cache line and per SIMD
+ * register); the wide ones keep large profit sums from overflowing.
+ *
+ * @param pallets Pallets of the instance.
+ * @param capacity Truck capacity.
+ * @return Width to instantiate the solvers with.
+ */
+inline KeyWidth chooseKeyWidth(const std::vector<Pallet>& pallets, int capacity) {
+    int bits = requiredKeyBits(pallets, capacity);
+    if (bits <= 31) return KeyWidth::Bits32;
+    if (bits <= 63) return KeyWidth::Bits64;
+    return KeyWidth::Bits128;
+}
+
+/**
+ * @brief Bit layout of the packed objective for one instance.
+ *
+ * key = profit << (countBits + weightBits)
+ *     | (countBase - count) << weightBits
+ *     | (weightBase - weight)
+ *
+ * The count and weight fields are stored negated (counted down from their
+ * maximum), so a larger key is always the better load. Since the count of a
+ * load never exceeds n and its weight never exceeds the capacity, the fields
+ * never borrow from each other and the key of a load is simply the key of
+ * the empty load plus the keys of its pallets. Every feasible load has a
+ * non-negative key, so -1 can be used as "no load yet". If the instance does
+ * not fit in Key, the weight field and then the count field are dropped
+ * (those tie-breaks are then not applied); chooseKeyWidth() avoids that.
+ *
+ * @tparam Key Signed integer type holding the key (int16_t up to __int128).
+ */
+template <typename Key>
+struct ObjectiveKey {
+    int countBits;
+    int weightBits;
+    Key countBase;
+    Key weightBase;
+
+    /**
+     * @brief Chooses the layout for an instance.
+     *
+     * @param pallets Pallets of the instance.
+     * @param capacity Truck capacity.
+     * @return Layout wide enough for every feasible load.
+     */
+    static ObjectiveKey forInstance(const std::vector<Pallet>& pallets, int capacity) {
+        const int available = static_cast<int>(sizeof(Key)) * 8 - 1;
+
+        long long profitSum = 0;
+        for (const auto& p : pallets) profitSum += p.profit;
+
+        int profitBits = bitWidth(profitSum);
+        int countBits = bitWidth(static_cast<long long>(pallets.size()));
+        int weightBits = bitWidth(capacity > 0 ? capacity : 0);
+
+        if (profitBits + countBits + weightBits > available) weightBits = 0;
+        if (profitBits + countBits + weightBits > available) countBits = 0;
+
+        return ObjectiveKey{countBits, weightBits,
+                            static_cast<Key>((Key(1) << countBits) - 1),
+                            static_cast<Key>((Key(1) << weightBits) - 1)};
+    }
+
+    /**
+     * @brief Key of the empty load.
+     * @return Packed key with zero profit, zero pallets and zero weight.
+     */
+    Key emptyKey() const {
+        return (countBase << weightBits) | weightBase;
+    }
+
+    /**
+     * @brief Amount a pallet adds to the key of any load it joins.
+     * @param p Pallet.
+     * @return Key increment (profit up, count and weight down).
+     */
+    Key itemKey(const Pallet& p) const {
+        Key key = static_cast<Key>(p.profit) << (countBits + weightBits);
+        if (countBits > 0) key -= Key(1) << weightBits;
+        if (weightBits > 0) key -= p.weight;
+        return key;
+    }
+
+    /**
+     * @brief Extracts the profit of a key.
+     * @param key Packed key.
+     * @return Total profit.
+     */
+    long long profit(Key key) const {
+        return static_cast<long long>(key >> (countBits + weightBits));
+    }
+
+    /**
+     * @brief Extracts the number of pallets of a key.
+     * @param key Packed key of a load (not below emptyKey()).
+     * @return Pallet count, or 0 when the layout does not keep it (countBits == 0).
+     */
+    long long count(Key key) const {
+        return static_cast<long long>(countBase - ((key >> weightBits) & countBase));
+    }
+};
+
+#endif
@@ -0,0 +1,289 @@
+/**
+ * @file preprocess.cpp
+ * @brief Implementation of the instance reductions.
+ *
+ * @author Luís Martins e João Taveira
+ * @date 2025-05-20
+ */
+
+#include "preprocess.h"
+#include "efficiency.h"
+#include "workspace.h"
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <string>
+
+namespace {
+    /**
+     * @brief Whether KNAPSACK_PREPROCESS turns the reductions off.
+     */
+    bool preprocessingDisabled() {
+        const char* value = std::getenv("KNAPSACK_PREPROCESS");
+        if (!value) return false;
+        std::string mode = value;
+        return mode == "off" || mode == "0" || mode == "no";
+    }
+
+    /**
+     * @brief Cells of a full DP table for n pallets and a capacity.
+     */
+    long long tableCells(size_t n, int capacity) {
+        return (static_cast<long long>(n) + 1) * (static_cast<long long>(capacity) + 1);
+    }
+
+    /**
+     * @brief Marks the pallets whose strict dominators cannot all fit next to them.
+     *
+     * Pallets are visited by increasing weight while a Fenwick tree, indexed
+     * by profit rank (highest profit first), accumulates the weight of the
+     * lighter pallets already seen. For pallet j the dominators are the
+     * lighter pallets with profit >= p_j plus the pallets of the same weight
+     * with profit > p_j. O(n log n).
+     *
+     * @param pallets Pallets with positive profit, none heavier than the truck.
+     * @param capacity Truck capacity.
+     * @param dominated Output flags, one per pallet.
+     */
+    void markDominated(const std::vector<Pallet>& pallets, int capacity, std::vector<char>& dominated) {
+        int n = pallets.size();
+        dominated.assign(n, 0);
+
+        std::vector<int> profits(n);
+        for (int i = 0; i < n; ++i) profits[i] = pallets[i].profit;
+        std::sort(profits.begin(), profits.end(), std::greater<int>());
+        profits.erase(std::unique(profits.begin(), profits.end()), profits.end());
+        auto rankOf = [&profits](int profit) {
+            return static_cast<int>(std::lower_bound(profits.begin(), profits.end(), profit, std::greater<int>())
+                                    - profits.begin()) + 1;
+        };
+
+        // Fenwick: soma dos pesos das paletes já vistas com lucro de posto <= r
+        std::vector<long long> tree(profits.size() + 1, 0);
+        auto add = [&tree](int r, long long value) {
+            for (; r < static_cast<int>(tree.size()); r += r & -r) tree[r] += value;
+        };
+        auto sum = [&tree](int r) {
+            long long total = 0;
+            for (; r > 0; r -= r & -r) total += tree[r];
+            return total;
+        };
+
+        std::vector<int> order(n);
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&pallets](int a, int b) {
+            if (pallets[a].weight != pallets[b].weight) return pallets[a].weight < pallets[b].weight;
+            return pallets[a].profit > pallets[b].profit;
+        });
+
+        for (int begin = 0; begin < n;) {
+            int weight = pallets[order[begin]].weight;
+            int end = begin;
+            while (end < n && pallets[order[end]].weight == weight) ++end;
+
+            // Dentro do grupo (lucro decrescente), as paletes antes de j com lucro maior dominam-na
+            int better = 0;
+            for (int k = begin; k < end; ++k) {
+                const Pallet& p = pallets[order[k]];
+                if (k > begin && pallets[order[k - 1]].profit > p.profit) better = k - begin;
+                long long dominators = sum(rankOf(p.profit)) + static_cast<long long>(better) * weight;
+                if (dominators + p.weight > capacity) dominated[order[k]] = 1;
+            }
+            for (int k = begin; k < end; ++k) add(rankOf(pallets[order[k]].profit), weight);
+            begin = end;
+        }
+    }
+
+    /**
+     * @brief Fixes pallets in or out by comparing LP bounds with the greedy load.
+     *
+     * With LB the profit of the greedy load (the one of KProxy), a pallet
+     * whose bound when forced out is below LB belongs to every load of
+     * maximum profit, and one whose bound when forced in is below LB to
+     * none. Bounds and LB are integers, so the comparison is strict.
+     *
+     * @param pallets Pallets with positive profit, none heavier than the truck.
+     * @param capacity Truck capacity.
+     * @param workspace Buffers for the efficiency order and the LP prefix sums.
+     * @param fixed Output, one per pallet: 1 fixed in, -1 fixed out, 0 free.
+     */
+    void markFixed(const std::vector<Pallet>& pallets, int capacity, SolverWorkspace& workspace,
+                   std::vector<signed char>& fixed) {
+        int n = pallets.size();
+        fixed.assign(n, 0);
+        if (n == 0) return;
+
+        std::vector<int>& order = workspace.order;
+        efficiencyOrder(pallets, order);
+        std::vector<Pallet>& sorted = workspace.sorted;
+        sorted.clear();
+        for (int i : order) sorted.push_back(pallets[i]);
+
+        // Limite inferior: carga gulosa, como KProxy
+        long long lower = 0;
+        long long used = 0;
+        for (const Pallet& p : sorted) {
+            if (used + p.weight <= capacity) {
+                used += p.weight;
+                lower += p.profit;
+            }
+        }
+
+        LPBound bound(sorted, workspace.prefWeight, workspace.prefProfit);
+        for (int j = 0; j < n; ++j) {
+            const Pallet& p = sorted[j];
+            if (bound.without(j, capacity) < lower) fixed[order[j]] = 1;
+            else if (p.profit + bound.without(j, capacity - p.weight) < lower) fixed[order[j]] = -1;
+        }
+    }
+}
+
+ReducedInstance reduceInstance(const std::vector<Pallet>& pallets, int capacity) {
+    SolverWorkspace workspace;
+    return reduceInstance(pallets, capacity, workspace);
+}
+
+ReducedInstance reduceInstance(const std::vector<Pallet>& pallets, int capacity, SolverWorkspace& workspace) {
+    ReducedInstance reduced;
+    reduced.capacity = capacity;
+    reduced.report = PreprocessReport{{}, {}, {}, {}, {}, 1, false, tableCells(pallets.size(), capacity), 0};
+    if (preprocessingDisabled() || capacity < 0) {
+        reduced.pallets = pallets;
+        reduced.positions.resize(pallets.size());
+        std::iota(reduced.positions.begin(), reduced.positions.end(), 0);
+        reduced.report.cellsAfter = reduced.report.cellsBefore;
+        return reduced;
+    }
+    PreprocessReport& report = reduced.report;
+
+    // Paletes que nunca entram numa carga ótima
+    std::vector<Pallet> kept;
+    std::vector<int> keptPositions;
+    long long totalWeight = 0;
+    for (size_t i = 0; i < pallets.size(); ++i) {
+        const Pallet& p = pallets[i];
+        if (p.weight > capacity) report.oversized.push_back(p.id);
+        else if (p.profit <= 0) report.zeroProfit.push_back(p.id);
+        else {
+            kept.push_back(p);
+            keptPositions.push_back(static_cast<int>(i));
+            totalWeight += p.weight;
+        }
+    }
+
+    // Cabe tudo: a solução é levar todas as paletes restantes
+    if (totalWeight <= capacity) {
+        report.fitsAll = true;
+        reduced.pallets = kept;
+        reduced.positions = keptPositions;
+        return reduced;
+    }
+
+    std::vector<char> dominated;
+    markDominated(kept, capacity, dominated);
+    std::vector<Pallet> survivors;
+    std::vector<int> survivorPositions;
+    for (size_t i = 0; i < kept.size(); ++i) {
+        if (dominated[i]) report.dominated.push_back(kept[i].id);
+        else {
+            survivors.push_back(kept[i]);
+            survivorPositions.push_back(keptPositions[i]);
+        }
+    }
+
+    // Fixar paletes pelos limites LP; as fixadas dentro gastam capacidade
+    std::vector<signed char> fixed;
+    markFixed(survivors, capacity, workspace, fixed);
+    totalWeight = 0;
+    for (size_t i = 0; i < survivors.size(); ++i) {
+        if (fixed[i] > 0) {
+            report.fixedIn.push_back(survivors[i].id);
+            reduced.fixedIn.push_back(survivors[i]);
+            reduced.fixedInPositions.push_back(survivorPositions[i]);
+            reduced.capacity -= survivors[i].weight;
+        } else if (fixed[i] < 0) {
+            report.fixedOut.push_back(survivors[i].id);
+        } else {
+            reduced.pallets.push_back(survivors[i]);
+            reduced.positions.push_back(survivorPositions[i]);
+            totalWeight += survivors[i].weight;
+        }
+    }
+
+    if (totalWeight <= reduced.capacity) {
+        report.fitsAll = true;
+        return reduced;
+    }
+
+    // Dividir pesos e capacidade pelo MDC dos pesos
+    int divisor = 0;
+    for (const Pallet& p : reduced.pallets) divisor = std::gcd(divisor, p.weight);
+    if (divisor > 1) {
+        for (Pallet& p : reduced.pallets) p.weight /= divisor;
+        reduced.capacity /= divisor;
+        report.weightScale = divisor;
+    }
+
+    report.cellsAfter = tableCells(reduced.pallets.size(), reduced.capacity);
+    return reduced;
+}
+
+ILPResult expandResult(const ReducedInstance& reduced, const ILPResult& result) {
+    ILPResult expanded{{}, result.totalProfit, result.totalWeight * reduced.report.weightScale};
+
+    // A seleção é uma subsequência das paletes restantes: recuperar o índice original de cada uma
+    std::vector<int> selectedPositions;
+    size_t next = 0;
+    for (int id : result.selectedPallets) {
+        while (next < reduced.pallets.size() && reduced.pallets[next].id != id) ++next;
+        if (next == reduced.pallets.size()) break;
+        selectedPositions.push_back(reduced.positions[next++]);
+    }
+
+    // Juntar com as paletes fixadas, pela ordem original
+    size_t a = 0, b = 0;
+    while (a < selectedPositions.size() || b < reduced.fixedIn.size()) {
+        if (b == reduced.fixedIn.size() ||
+            (a < selectedPositions.size() && selectedPositions[a] < reduced.fixedInPositions[b])) {
+            expanded.selectedPallets.push_back(result.selectedPallets[a++]);
+        } else {
+            const Pallet& p = reduced.fixedIn[b++];
+            expanded.selectedPallets.push_back(p.id);
+            expanded.totalProfit += p.profit;
+            expanded.totalWeight += p.weight;
+        }
+    }
+    return expanded;
+}
+
+ILPResult solvePreprocessed(const std::vector<Pallet>& pallets, int capacity,
+                            const std::function<ILPResult(const std::vector<Pallet>&, int)>& solve,
+                            PreprocessReport& report) {
+    SolverWorkspace workspace;
+    ILPResult result;
+    solvePreprocessed(pallets, capacity, [&solve](const std::vector<Pallet>& reduced, int c, SolverWorkspace&,
+                                                  ILPResult& out) { out = solve(reduced, c); },
+                      workspace, report, result);
+    return result;
+}
+
+void solvePreprocessed(const std::vector<Pallet>& pallets, int capacity, const WorkspaceSolver& solve,
+                       SolverWorkspace& workspace, PreprocessReport& report, ILPResult& result) {
+    ReducedInstance reduced = reduceInstance(pallets, capacity, workspace);
+    report = reduced.report;
+
+    ILPResult& partial = workspace.partial;
+    if (report.fitsAll) {
+        partial.selectedPallets.clear();
+        partial.totalProfit = 0;
+        partial.totalWeight = 0;
+        for (const Pallet& p : reduced.pallets) {
+            partial.selectedPallets.push_back(p.id);
+            partial.totalProfit += p.profit;
+            partial.totalWeight += p.weight;
+        }
+    } else {
+        solve(reduced.pallets, reduced.capacity, workspace, partial);
+    }
+    result = expandResult(reduced, partial);
+}
@@ -0,0 +1,134 @@
+/**
+ * @file preprocess.h
+ * @brief Reductions applied to an instance before the exact solvers run.
+ *
+ * Every step keeps the optimal selection unchanged under the objective of
+ * the exact solvers (profit, then fewest pallets, then lowest weight, same
+ * tie rule):
+ * - pallets heavier than the truck, or with no profit, are never chosen;
+ * - if everything left fits, the answer is every pallet left;
+ * - a pallet is dropped when the pallets that dominate it (no heavier, no
+ *   less profitable, better in one of the two) cannot all fit next to it,
+ *   since any load with it could swap it for a dominator left out;
+ * - a pallet is fixed in (out) when the LP bound with it forced out (in) is
+ *   below the profit of the greedy load (Ingargiola-Korsh / Martello-Toth
+ *   reduction): no load of maximum profit can then leave it out (take it);
+ * - weights and capacity are divided by the GCD of the weights, which
+ *   shrinks the DP table by that factor.
+ *
+ * @author Luís Martins e João Taveira
+ * @date 2025-05-20
+ */
+
+#ifndef PREPROCESS_H
+#define PREPROCESS_H
+
+#include <functional>
+#include <vector>
+#include "Pallet.h"
+#include "algorithms.h"
+
+/**
+ * @brief What the reductions removed, and the effect on the DP table.
+ */
+struct PreprocessReport {
+    std::vector<int> oversized;    // IDs mais pesados do que o camião
+    std::vector<int> zeroProfit;   // IDs sem lucro
+    std::vector<int> dominated;    // IDs dominados por paletes que não cabem todas com eles
+    std::vector<int> fixedIn;      // IDs em todas as cargas ótimas (limite LP sem eles < guloso)
+    std::vector<int> fixedOut;     // IDs em nenhuma carga ótima (limite LP com eles < guloso)
+    int weightScale;               // MDC dos pesos (1 = sem mudança)
+    bool fitsAll;                  // as paletes restantes cabem todas
+    long long cellsBefore;         // células da tabela da DP: (n + 1) * (C + 1)
+    long long cellsAfter;          // idem, após a redução (0 se cabem todas)
+};
+
+/**
+ * @brief Reduced instance, with weights and capacity divided by weightScale.
+ *
+ * The capacity left is the truck capacity minus the weight of the pallets
+ * fixed in, which are added back by expandResult().
+ */
+struct ReducedInstance {
+    std::vector<Pallet> pallets;        // paletes restantes, pela ordem original
+    std::vector<int> positions;         // índice original de cada palete restante
+    std::vector<Pallet> fixedIn;        // paletes fixadas na carga (pesos originais)
+    std::vector<int> fixedInPositions;  // índice original de cada palete fixada
+    int capacity;
+    PreprocessReport report;
+};
+
+/**
+ * @brief Applies the reductions to an instance.
+ *
+ * KNAPSACK_PREPROCESS=off returns the instance unchanged.
+ *
+ * @param pallets Loaded pallets.
+ * @param capacity Truck capacity.
+ * @return Reduced instance and report.
+ */
+ReducedInstance reduceInstance(const std::vector<Pallet>& pallets, int capacity);
+
+/**
+ * @brief reduceInstance() on the buffers of a reusable workspace.
+ *
+ * The efficiency order and LP prefix sums of the fixing step go to the
+ * workspace instead of fresh vectors.
+ *
+ * @param pallets Loaded pallets.
+ * @param capacity Truck capacity.
+ * @param workspace Buffers reused across solves.
+ * @return Reduced instance and report.
+ */
+ReducedInstance reduceInstance(const std::vector<Pallet>& pallets, int capacity, SolverWorkspace& workspace);
+
+/**
+ * @brief Maps a result on the reduced instance back to the original instance.
+ *
+ * Adds the pallets fixed in (keeping input order) and restores the
+ * original weights.
+ *
+ * @param reduced Reduced instance.
+ * @param result Result computed on reduced.pallets and reduced.capacity.
+ * @return Result on the original instance.
+ */
+ILPResult expandResult(const ReducedInstance& reduced, const ILPResult& result);
+
+/**
+ * @brief Reduces an instance, solves what is left and expands the result.
+ *
+ * When every remaining pallet fits, the solver is not called.
+ *
+ * @param pallets Loaded pallets.
+ * @param capacity Truck capacity.
+ * @param solve Exact solver (e.g. solveDynamic).
+ * @param report Output report of the reductions.
+ * @return Same selection as solve(pallets, capacity).
+ */
+ILPResult solvePreprocessed(const std::vector<Pallet>& pallets, int capacity,
+                            const std::function<ILPResult(const std::vector<Pallet>&, int)>& solve,
+                            PreprocessReport& report);
+
+/**
+ * @brief Exact solver on the buffers of a workspace, writing into a caller-owned result.
+ */
+using WorkspaceSolver = std::function<void(const std::vector<Pallet>&, int, SolverWorkspace&, ILPResult&)>;
+
+/**
+ * @brief solvePreprocessed() on the buffers of a reusable workspace.
+ *
+ * The reductions and the solver share the workspace, so a program that
+ * keeps one reuses the DP tables and search trails across solves. The
+ * reduced instance itself is rebuilt on every call (O(n)).
+ *
+ * @param pallets Loaded pallets.
+ * @param capacity Truck capacity.
+ * @param solve Exact solver (e.g. the workspace overload of solveDynamic()).
+ * @param workspace Buffers reused across solves.
+ * @param report Output report of the reductions.
+ * @param result Reference to store the solution, same as solve on the whole instance.
+ */
+void solvePreprocessed(const std::vector<Pallet>& pallets, int capacity, const WorkspaceSolver& solve,
+                       SolverWorkspace& workspace, PreprocessReport& report, ILPResult& result);
+
+#endif
@@ -0,0 +1,169 @@
+/**
+ * @file solver_templates.h
+ * @brief Compile-time specialized solvers for small knapsack instances.
+ *
+ * The solver is instantiated for a key width (int16_t, int32_t, int64_t)
+ * and handles at most SMALL_PALLETS pallets. Pallets live in fixed-size
+ * arrays and a load is a bit mask, so a solve performs no heap allocation.
+ * tryEnumerateSmall() picks the instantiation at runtime.
+ *
+ * @author Luís Martins e João Taveira
+ * @date 2025-05-20
+ */
+
+#ifndef SOLVER_TEMPLATES_H
+#define SOLVER_TEMPLATES_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "Pallet.h"
+#include "algorithms.h"
+#include "objective.h"
+
+/**
+ * @brief Largest instance solved by SmallKnapsack (2^16 subsets).
+ */
+constexpr int SMALL_PALLETS = 16;
+
+/**
+ * @brief Best load found by SmallKnapsack.
+ *
+ * Bit i of mask is set when the i-th input pallet is loaded.
+ */
+struct SmallSolution {
+    long long profit;
+    int weight;
+    uint64_t mask;
+};
+
+/**
+ * @brief Exact solver for at most SMALL_PALLETS pallets.
+ *
+ * Every subset is enumerated in Gray-code order, so each step adds or
+ * removes a single pallet. Loads with equal keys are resolved by the
+ * smaller mask, which is the same "leave out the last differing pallet"
+ * rule as the other exact solvers. Larger instances belong to the general
+ * solvers: a pruned search here would lack the symmetry and equal-profit
+ * pruning of solveILP().
+ *
+ * @tparam Key Signed integer type of the packed key.
+ */
+template <typename Key>
+class SmallKnapsack {
+public:
+    /**
+     * @brief Solves an instance with at most SMALL_PALLETS pallets.
+     *
+     * @param pallets Pallets of the instance (size <= SMALL_PALLETS).
+     * @param capacity Truck capacity.
+     * @return Best load.
+     */
+    static SmallSolution solve(const std::vector<Pallet>& pallets, int capacity) {
+        SmallKnapsack solver(pallets, capacity);
+        solver.enumerate();
+        return SmallSolution{solver.profitOf(solver.bestKey), solver.bestWeight, solver.bestMask};
+    }
+
+private:
+    SmallKnapsack(const std::vector<Pallet>& pallets, int capacity)
+        : n(static_cast<int>(pallets.size())), capacity(capacity),
+          objective(ObjectiveKey<Key>::forInstance(pallets, capacity)) {
+        emptyKey = objective.emptyKey();
+        for (int i = 0; i < n; ++i) {
+            weights[i] = pallets[i].weight;
+            keys[i] = objective.itemKey(pallets[i]);
+        }
+
+        bestKey = capacity >= 0 ? emptyKey : Key(-1);
+        bestWeight = 0;
+        bestMask = 0;
+    }
+
+    long long profitOf(Key key) const {
+        return key < 0 ? 0 : objective.profit(key);
+    }
+
+    void offer(Key key, int weight, uint64_t mask) {
+        if (key > bestKey || (key == bestKey && mask < bestMask)) {
+            bestKey = key;
+            bestWeight = weight;
+            bestMask = mask;
+        }
+    }
+
+    /**
+     * @brief Gray-code enumeration of every subset.
+     */
+    void enumerate() {
+        if (capacity < 0) return;
+
+        uint64_t mask = 0;
+        Key key = emptyKey;
+        int weight = 0;
+        const uint64_t subsets = uint64_t(1) << n;
+
+        for (uint64_t g = 1; g < subsets; ++g) {
+            int bit = __builtin_ctzll(g);
+            uint64_t flag = uint64_t(1) << bit;
+            mask ^= flag;
+            if (mask & flag) {
+                key += keys[bit];
+                weight += weights[bit];
+            } else {
+                key -= keys[bit];
+                weight -= weights[bit];
+            }
+            if (weight <= capacity) offer(key, weight, mask);
+        }
+    }
+
+    int n;
+    int capacity;
+    ObjectiveKey<Key> objective;
+    Key emptyKey;
+    std::array<int, SMALL_PALLETS> weights{};
+    std::array<Key, SMALL_PALLETS> keys{};
+    Key bestKey;
+    int bestWeight;
+    uint64_t bestMask;
+};
+
+/**
+ * @brief Runs one instantiation and converts its mask to an ILPResult.
+ *
+ * Writes into the caller's result, so its selection keeps its capacity.
+ */
+template <typename Key>
+void solveSmallWith(const std::vector<Pallet>& pallets, int capacity, ILPResult& result) {
+    SmallSolution best = SmallKnapsack<Key>::solve(pallets, capacity);
+
+    result.totalProfit = best.profit;
+    result.totalWeight = best.weight;
+    result.selectedPallets.clear();
+    for (int i = 0; i < static_cast<int>(pallets.size()); ++i) {
+        if ((best.mask >> i) & 1) result.selectedPallets.push_back(pallets[i].id);
+    }
+}
+
+/**
+ * @brief Solves an instance by Gray-code enumeration when it has at most SMALL_PALLETS pallets.
+ *
+ * @param pallets Pallets of the instance.
+ * @param capacity Truck capacity.
+ * @param result Reference to store the solution.
+ * @return false if the instance has more than SMALL_PALLETS pallets or
+ *         needs a 128-bit key, in which case the caller must use a general solver.
+ */
+inline bool tryEnumerateSmall(const std::vector<Pallet>& pallets, int capacity, ILPResult& result) {
+    if (pallets.size() > SMALL_PALLETS) return false;
+
+    int bits = requiredKeyBits(pallets, capacity);
+    if (bits <= 15) solveSmallWith<int16_t>(pallets, capacity, result);
+    else if (bits <= 31) solveSmallWith<int32_t>(pallets, capacity, result);
+    else if (bits <= 63) solveSmallWith<int64_t>(pallets, capacity, result);
+    else return false;
+    return true;
+}
+
+#endif
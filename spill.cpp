@@ -0,0 +1,132 @@
+/**
+ * @file spill.cpp
+ * @brief Implementation of the in-memory / on-disk decision rows.
+ *
+ * @author Luís Martins e João Taveira
+ * @date 2025-05-20
+ */
+
+#include "spill.h"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define KNAPSACK_CAN_SPILL 1
+#else
+#define KNAPSACK_CAN_SPILL 0
+#endif
+
+namespace {
+    /**
+     * @brief Creates and unlinks a scratch file when the decisions are too big.
+     *
+     * @param bytes Size of all decision rows.
+     * @return File descriptor, or -1 to keep the decisions in memory.
+     */
+    int openScratch(size_t bytes) {
+        if (bytes <= spillThresholdBytes()) return -1;
+
+#if KNAPSACK_CAN_SPILL
+        std::string dir;
+        if (const char* value = std::getenv("KNAPSACK_SCRATCH_DIR")) dir = value;
+        else if (const char* value = std::getenv("TMPDIR")) dir = value;
+        else dir = "/tmp";
+
+        std::string path = dir + "/knapsack-decisions-XXXXXX";
+        std::vector<char> name(path.begin(), path.end());
+        name.push_back('\0');
+
+        int fd = mkstemp(name.data());
+        if (fd >= 0) {
+            // Apagado já: o espaço é libertado quando o descritor fecha, mesmo após um crash
+            unlink(name.data());
+            return fd;
+        }
+        std::cerr << "Could not create scratch file in " << dir << "; keeping DP decisions in memory\n";
+#endif
+        return -1;
+    }
+}
+
+size_t spillThresholdBytes() {
+    if (const char* value = std::getenv("KNAPSACK_SPILL_BYTES")) {
+        return std::strtoull(value, nullptr, 10);
+    }
+#if KNAPSACK_CAN_SPILL && defined(_SC_PHYS_PAGES)
+    long pages = sysconf(_SC_PHYS_PAGES);
+    long pageSize = sysconf(_SC_PAGESIZE);
+    if (pages > 0 && pageSize > 0) return static_cast<size_t>(pages) * pageSize / 4;
+#endif
+    return size_t(1) << 32;
+}
+
+DecisionRows::DecisionRows(size_t rows, size_t words, size_t bandSize)
+    : rows(rows), words(words), fd(openScratch(rows * words * sizeof(uint64_t))),
+      memory(fd >= 0 ? bandSize : rows, words) {}
+
+DecisionRows::~DecisionRows() {
+#if KNAPSACK_CAN_SPILL
+    if (mapped) munmap(const_cast<uint64_t*>(mapped), mappedBytes);
+    if (fd >= 0) close(fd);
+#endif
+}
+
+uint64_t* DecisionRows::bandRow(size_t first, size_t k) {
+    return fd >= 0 ? memory.row(k) : memory.row(first + k);
+}
+
+bool DecisionRows::commitBand(size_t first, size_t count) {
+#if KNAPSACK_CAN_SPILL
+    if (fd < 0) return true;
+
+    // Escrita sequencial: as bandas chegam por ordem, linha a linha
+    const size_t rowBytes = words * sizeof(uint64_t);
+    for (size_t k = 0; k < count; ++k) {
+        const char* data = reinterpret_cast<const char*>(memory.row(k));
+        off_t offset = static_cast<off_t>((first + k) * rowBytes);
+        size_t done = 0;
+        while (done < rowBytes) {
+            ssize_t written = pwrite(fd, data + done, rowBytes - done, offset + done);
+            if (written < 0 && errno == EINTR) continue; // interrompida por um sinal: repetir
+            if (written <= 0) {
+                const char* reason = written < 0 ? std::strerror(errno) : "no bytes written";
+                std::cerr << "Could not write DP decisions to the scratch file: " << reason << "\n";
+                return false;
+            }
+            done += written;
+        }
+    }
+#else
+    (void)first;
+    (void)count;
+#endif
+    return true;
+}
+
+bool DecisionRows::finish() {
+#if KNAPSACK_CAN_SPILL
+    if (fd < 0 || rows == 0 || words == 0) return true;
+
+    mappedBytes = rows * words * sizeof(uint64_t);
+    void* data = mmap(nullptr, mappedBytes, PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        std::cerr << "Could not map the DP scratch file: " << std::strerror(errno) << "\n";
+        return false;
+    }
+
+    // A reconstrução lê uma palavra por linha, de trás para a frente
+    madvise(data, mappedBytes, MADV_RANDOM);
+    mapped = static_cast<const uint64_t*>(data);
+#endif
+    return true;
+}
+
+const uint64_t* DecisionRows::rowData(size_t row) const {
+    return fd >= 0 ? mapped + row * words : memory.row(row);
+}
@@ -0,0 +1,118 @@
+/**
+ * @file spill.h
+ * @brief Decision bits of a DP kept in memory or spilled to a scratch file.
+ *
+ * The cache-blocked DP keeps one bit per (pallet, capacity) cell for the
+ * reconstruction. When those bits would not fit in memory, they are
+ * appended to an unlinked scratch file band by band (sequential writes
+ * only) and mapped read-only once the DP is done, so the reconstruction,
+ * which walks the rows backwards touching one word per row, pages in only
+ * what it reads. Peak RAM is then the two DP rows plus one band of
+ * decision rows.
+ *
+ * KNAPSACK_SPILL_BYTES overrides the size above which decisions go to disk
+ * (default: a quarter of physical memory) and KNAPSACK_SCRATCH_DIR the
+ * directory of the scratch file (default: TMPDIR, then /tmp).
+ *
+ * @author Luís Martins e João Taveira
+ * @date 2025-05-20
+ */
+
+#ifndef SPILL_H
+#define SPILL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "dp_storage.h"
+
+/**
+ * @brief Size above which DP decision bits are spilled to disk.
+ * @return Threshold in bytes.
+ */
+size_t spillThresholdBytes();
+
+/**
+ * @brief Rows of decision bits, written one band at a time.
+ *
+ * Usage: for every band, fill bandRow(0..count-1) and call
+ * commitBand(first, count) with bands in increasing row order; then call
+ * finish() and query taken().
+ */
+class DecisionRows {
+public:
+    /**
+     * @brief Prepares storage for rows x words bits.
+     *
+     * Falls back to memory (with a message on std::cerr) if the scratch file
+     * cannot be created.
+     *
+     * @param rows Number of rows (pallets).
+     * @param words 64-bit words per row.
+     * @param bandSize Maximum rows per band.
+     */
+    DecisionRows(size_t rows, size_t words, size_t bandSize);
+    ~DecisionRows();
+
+    DecisionRows(const DecisionRows&) = delete;
+    DecisionRows& operator=(const DecisionRows&) = delete;
+
+    /**
+     * @brief Buffer of the k-th row of the band being computed.
+     * @param first First row of the band.
+     * @param k Position in the band.
+     * @return words writable words.
+     */
+    uint64_t* bandRow(size_t first, size_t k);
+
+    /**
+     * @brief Stores the rows first..first+count-1 of the current band.
+     * @param first First row of the band.
+     * @param count Rows in the band.
+     * @return false if writing to the scratch file failed (the cause is printed to stderr).
+     */
+    bool commitBand(size_t first, size_t count);
+
+    /**
+     * @brief Ends the writing phase.
+     * @return false if the scratch file could not be mapped back (the cause is printed to stderr).
+     */
+    bool finish();
+
+    /**
+     * @brief Decision bit of a cell.
+     * @param row Row (pallet).
+     * @param w Capacity.
+     * @return true if the pallet was taken at that capacity.
+     */
+    bool taken(size_t row, size_t w) const {
+        return (rowData(row)[w / 64] >> (w % 64)) & 1;
+    }
+
+    /**
+     * @brief Whether the rows live in a scratch file.
+     * @return true when spilled.
+     */
+    bool onDisk() const { return fd >= 0; }
+
+    /**
+     * @brief Memory of the decision rows kept in memory (one band when on disk).
+     *
+     * Same cost as AlignedBlock::report().
+     *
+     * @return Report of the in-memory rows.
+     */
+    DpMemoryReport memoryReport() const { return memory.storage().report(memory.storage().size()); }
+
+private:
+    const uint64_t* rowData(size_t row) const;
+
+    size_t rows;
+    size_t words;
+    int fd;                      // ficheiro temporário, -1 quando tudo fica em memória
+    DpMatrix<uint64_t> memory;   // todas as linhas (em memória) ou só a banda atual (em disco)
+    const uint64_t* mapped = nullptr;
+    size_t mappedBytes = 0;
+};
+
+#endif
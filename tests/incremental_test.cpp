@@ -0,0 +1,353 @@
+/**
+ * @file incremental_test.cpp
+ * @brief Differential checks of the incremental solvers against solveDynamic().
+ *
+ * Each check replays random pallet streams through one API of
+ * incremental.h and compares every intermediate answer with a solve from
+ * scratch of the pallets present at that moment. Selections are checked
+ * for feasibility and profit: the rows hold profit alone, so on ties these
+ * solvers keep other loads than solveDynamic() (see incremental.h). The
+ * tie_rule check pins down the rule of IncrementalKnapsack itself. Run with
+ * the name of one check, or without arguments to run them all.
+ *
+ * @author Luís Martins e João Taveira
+ * @date 2025-05-20
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "../algorithms.h"
+#include "../analysis.h"
+#include "../efficiency.h"
+#include "../incremental.h"
+
+namespace {
+    int failures = 0;
+
+    /**
+     * @brief Records a failed check.
+     * @param check Name of the check.
+     * @param round Random instance where it failed.
+     * @param what Description of the mismatch.
+     */
+    void fail(const char* check, int round, const std::string& what) {
+        std::cerr << check << " (round " << round << "): " << what << "\n";
+        ++failures;
+    }
+
+    /**
+     * @brief Draws a random pallet; one in eight has a profit near the 32-bit limit.
+     *
+     * @param rng Random generator.
+     * @param id ID of the pallet.
+     * @param maxWeight Largest weight drawn (weights start at 0).
+     * @return New pallet.
+     */
+    Pallet randomPallet(std::mt19937& rng, int id, int maxWeight) {
+        int weight = static_cast<int>(rng() % (maxWeight + 1));
+        int profit = rng() % 8 == 0 ? 2000000000 + static_cast<int>(rng() % 1000) : static_cast<int>(rng() % 30);
+        return Pallet{id, weight, profit};
+    }
+
+    /**
+     * @brief Checks that a selection only uses available pallets, fits and adds up.
+     *
+     * @param available Pallets that may be selected.
+     * @param capacity Truck capacity.
+     * @param result Selection to check.
+     * @return Empty string if the selection is valid, otherwise the problem.
+     */
+    std::string checkSelection(const std::vector<Pallet>& available, int capacity, const ILPResult& result) {
+        std::map<int, const Pallet*> byId;
+        for (const Pallet& p : available) byId[p.id] = &p;
+
+        long long weight = 0, profit = 0;
+        for (int id : result.selectedPallets) {
+            auto it = byId.find(id);
+            if (it == byId.end()) return "selected pallet " + std::to_string(id) + " is not available";
+            weight += it->second->weight;
+            profit += it->second->profit;
+            byId.erase(it); // cada palete só pode ser escolhida uma vez
+        }
+        if (weight > capacity) return "selection exceeds the capacity";
+        if (weight != result.totalWeight || profit != result.totalProfit) return "selection totals do not add up";
+        return "";
+    }
+
+    /**
+     * @brief IncrementalKnapsack: batches of new pallets, every capacity of the last row.
+     */
+    void checkIncremental() {
+        const char* name = "incremental";
+        std::mt19937 rng(53);
+        for (int round = 0; round < 500; ++round) {
+            int capacity = static_cast<int>(rng() % 200);
+            IncrementalKnapsack solver(capacity);
+            std::vector<Pallet> all;
+
+            for (int batch = 0; batch < 5; ++batch) {
+                std::vector<Pallet> added;
+                int count = static_cast<int>(rng() % 6);
+                for (int i = 0; i < count; ++i) {
+                    added.push_back(randomPallet(rng, static_cast<int>(all.size()) + 1, 50));
+                    all.push_back(added.back());
+                }
+                solver.addPallets(added);
+
+                ILPResult expected = solveDynamic(all, capacity);
+                ILPResult result = solver.getResult();
+                if (solver.size() != static_cast<int>(all.size())) fail(name, round, "wrong pallet count");
+                if (solver.getProfit() != expected.totalProfit || result.totalProfit != expected.totalProfit) {
+                    fail(name, round, "profit differs from solveDynamic");
+                }
+                std::string problem = checkSelection(all, capacity, result);
+                if (!problem.empty()) fail(name, round, problem);
+
+                // A última linha responde por todas as capacidades menores
+                int smaller = capacity > 0 ? static_cast<int>(rng() % capacity) : 0;
+                ILPResult partial = solver.getResult(smaller);
+                if (solver.getRow()[smaller] != solveDynamic(all, smaller).totalProfit
+                    || partial.totalProfit != solver.getRow()[smaller]) {
+                    fail(name, round, "row differs from solveDynamic at a smaller capacity");
+                }
+                problem = checkSelection(all, smaller, partial);
+                if (!problem.empty()) fail(name, round, problem);
+            }
+        }
+    }
+
+    /**
+     * @brief IncrementalKnapsack keeps the earliest pallets among equally profitable loads.
+     *
+     * Taking a pallet only on a strict improvement means the load returned
+     * is, among the most profitable ones, the one whose last differing
+     * pallet is left out: the smallest mask when pallet i is bit i. Small
+     * instances are checked against every subset.
+     */
+    void checkTieRule() {
+        const char* name = "tie_rule";
+        std::vector<Pallet> example = {{1, 1, 1}, {2, 1, 1}, {3, 2, 2}};
+        IncrementalKnapsack solver(2);
+        solver.addPallets(example);
+        if (solver.getResult().selectedPallets != std::vector<int>{1, 2}) fail(name, 0, "expected {1, 2}");
+        if (solveDynamic(example, 2).selectedPallets != std::vector<int>{3}) fail(name, 0, "solveDynamic expected {3}");
+        if (CapacityProfile(example, 2).selectionFor(2).selectedPallets != std::vector<int>{1, 2}) {
+            fail(name, 0, "CapacityProfile expected {1, 2}");
+        }
+
+        std::mt19937 rng(530);
+        for (int round = 0; round < 500; ++round) {
+            int n = 1 + static_cast<int>(rng() % 12);
+            int capacity = static_cast<int>(rng() % 20);
+            std::vector<Pallet> pallets;
+            for (int i = 0; i < n; ++i) {
+                int weight = static_cast<int>(rng() % 4);
+                pallets.push_back(Pallet{i + 1, weight, weight + static_cast<int>(rng() % 2)});
+            }
+
+            // Máscaras por ordem crescente: a primeira com o lucro máximo é a esperada
+            long long bestProfit = -1;
+            uint32_t bestMask = 0;
+            for (uint32_t mask = 0; mask < (1u << n); ++mask) {
+                long long weight = 0, profit = 0;
+                for (int i = 0; i < n; ++i) {
+                    if ((mask >> i) & 1) {
+                        weight += pallets[i].weight;
+                        profit += pallets[i].profit;
+                    }
+                }
+                if (weight <= capacity && profit > bestProfit) {
+                    bestProfit = profit;
+                    bestMask = mask;
+                }
+            }
+            std::vector<int> expected;
+            for (int i = 0; i < n; ++i) {
+                if ((bestMask >> i) & 1) expected.push_back(pallets[i].id);
+            }
+
+            IncrementalKnapsack incremental(capacity);
+            incremental.addPallets(pallets);
+            std::vector<int> selected = incremental.getResult().selectedPallets;
+            std::sort(selected.begin(), selected.end());
+            if (selected != expected) fail(name, round, "not the tie-breaking load");
+        }
+    }
+
+    /**
+     * @brief SlidingWindowKnapsack: random pushes and pops against a FIFO of the same pallets.
+     */
+    void checkSlidingWindow() {
+        const char* name = "sliding_window";
+        std::mt19937 rng(54);
+        for (int round = 0; round < 200; ++round) {
+            int capacity = static_cast<int>(rng() % 150);
+            SlidingWindowKnapsack window(capacity);
+            std::deque<Pallet> queue;
+            int nextId = 0;
+
+            for (int op = 0; op < 60; ++op) {
+                if (rng() % 3 != 0) {
+                    Pallet pallet = randomPallet(rng, ++nextId, 40);
+                    window.push(pallet);
+                    queue.push_back(pallet);
+                } else {
+                    if (window.pop() != !queue.empty()) fail(name, round, "pop() on the wrong window state");
+                    if (!queue.empty()) queue.pop_front();
+                }
+
+                std::vector<Pallet> present(queue.begin(), queue.end());
+                ILPResult expected = solveDynamic(present, capacity);
+                ILPResult result = window.getResult();
+                if (window.size() != static_cast<int>(present.size())) fail(name, round, "wrong window size");
+                if (window.getProfit() != expected.totalProfit || result.totalProfit != expected.totalProfit) {
+                    fail(name, round, "profit differs from solveDynamic");
+                }
+                std::string problem = checkSelection(present, capacity, result);
+                if (!problem.empty()) fail(name, round, problem);
+            }
+        }
+    }
+
+    /**
+     * @brief solveOfflineDynamic: arrivals, departures (also of unknown IDs) and queries.
+     */
+    void checkOfflineDynamic() {
+        const char* name = "offline_dynamic";
+        std::mt19937 rng(55);
+        for (int round = 0; round < 200; ++round) {
+            int capacity = static_cast<int>(rng() % 120);
+            std::vector<DockEvent> events;
+            std::map<int, Pallet> dock;
+            std::vector<long long> expected;
+            int nextId = 0;
+
+            for (int op = 0; op < 80; ++op) {
+                int kind = static_cast<int>(rng() % 5);
+                if (kind == 0 || dock.empty()) {
+                    Pallet pallet = randomPallet(rng, ++nextId, 40);
+                    events.push_back({DockEvent::Type::Arrive, pallet});
+                    dock[pallet.id] = pallet;
+                } else if (kind == 1) {
+                    auto it = dock.begin();
+                    std::advance(it, rng() % dock.size());
+                    events.push_back({DockEvent::Type::Leave, it->second});
+                    dock.erase(it);
+                } else if (kind == 2) {
+                    // Chegada repetida e saída desconhecida são ignoradas
+                    events.push_back({DockEvent::Type::Arrive, dock.begin()->second});
+                    events.push_back({DockEvent::Type::Leave, Pallet{-1, 0, 0}});
+                } else {
+                    events.push_back({DockEvent::Type::Query, Pallet{}});
+                    std::vector<Pallet> present;
+                    for (const auto& entry : dock) present.push_back(entry.second);
+                    expected.push_back(solveDynamic(present, capacity).totalProfit);
+                }
+            }
+
+            if (solveOfflineDynamic(capacity, events) != expected) {
+                fail(name, round, "query answers differ from solveDynamic");
+            }
+        }
+    }
+
+    /**
+     * @brief DynamicGreedy: adds, removes, reweights and capacity changes against a greedy scan.
+     */
+    void checkDynamicGreedy() {
+        const char* name = "dynamic_greedy";
+        std::mt19937 rng(56);
+        std::vector<int> order;
+        for (int round = 0; round < 200; ++round) {
+            int capacity = static_cast<int>(rng() % 200);
+            DynamicGreedy greedy(capacity);
+            std::map<int, Pallet> held; // por ID: é a ordem de desempate do DynamicGreedy
+
+            for (int op = 0; op < 200; ++op) {
+                int kind = static_cast<int>(rng() % 9);
+                int id = static_cast<int>(rng() % 30);
+                if (kind < 4) {
+                    Pallet pallet = randomPallet(rng, id, 40);
+                    greedy.add(pallet);
+                    held[id] = pallet;
+                } else if (kind < 6) {
+                    if (greedy.remove(id) != (held.erase(id) > 0)) fail(name, round, "remove() on the wrong state");
+                } else if (kind < 8) {
+                    Pallet pallet = randomPallet(rng, id, 40);
+                    bool known = held.count(id) > 0;
+                    if (greedy.update(pallet) != known) fail(name, round, "update() on the wrong state");
+                    if (known) held[id] = pallet;
+                } else {
+                    capacity = static_cast<int>(rng() % 200);
+                    greedy.setCapacity(capacity);
+                }
+
+                // Referência: percorrer as paletes por eficiência até à primeira que não cabe
+                std::vector<Pallet> present;
+                for (const auto& entry : held) present.push_back(entry.second);
+                efficiencyOrder(present, order);
+
+                long long weight = 0, profit = 0;
+                double bound = 0;
+                int breakPallet = -1;
+                for (int i : order) {
+                    const Pallet& p = present[i];
+                    if (weight + p.weight > capacity) {
+                        breakPallet = p.id;
+                        bound = profit + static_cast<double>(capacity - weight) * p.profit / p.weight;
+                        break;
+                    }
+                    weight += p.weight;
+                    profit += p.profit;
+                }
+                if (breakPallet < 0) bound = static_cast<double>(profit);
+
+                GreedyEstimate estimate = greedy.query();
+                if (greedy.size() != static_cast<int>(held.size())) fail(name, round, "wrong pallet count");
+                if (estimate.greedyProfit != profit || estimate.greedyWeight != weight
+                    || estimate.breakPallet != breakPallet) {
+                    fail(name, round, "greedy prefix differs from the efficiency order");
+                }
+                if (std::fabs(estimate.lpBound - bound) > 1e-9 * std::max(1.0, bound)) {
+                    fail(name, round, "LP bound differs from the efficiency order");
+                }
+            }
+        }
+    }
+
+    struct Check {
+        const char* name;
+        void (*run)();
+    };
+
+    const Check checks[] = {
+        {"incremental", checkIncremental},
+        {"tie_rule", checkTieRule},
+        {"sliding_window", checkSlidingWindow},
+        {"offline_dynamic", checkOfflineDynamic},
+        {"dynamic_greedy", checkDynamicGreedy},
+    };
+}
+
+int main(int argc, char** argv) {
+    bool ran = false;
+    for (const Check& check : checks) {
+        if (argc > 1 && std::strcmp(argv[1], check.name) != 0) continue;
+        check.run();
+        ran = true;
+    }
+    if (!ran) {
+        std::cerr << "Unknown check: " << argv[1] << "\n";
+        return 2;
+    }
+    if (failures > 0) std::cerr << failures << " mismatches\n";
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,348 @@
+/**
+ * @file solver_test.cpp
+ * @brief Differential checks of the exact solvers, the preprocessing and the cache.
+ *
+ * Every exact solver ranks loads with the same packed key and resolves
+ * exact ties by leaving out the last differing pallet, so on any instance
+ * they must return the same selection, not just the same profit. The
+ * instances mix uncorrelated pallets with tie-heavy ones (profit equal to
+ * weight, a few distinct values, identical pallets). Run with the name of
+ * one check, or without arguments to run them all.
+ *
+ * @author Luís Martins e João Taveira
+ * @date 2025-05-20
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "../algorithms.h"
+#include "../cache.h"
+#include "../preprocess.h"
+#include "../workspace.h"
+
+namespace {
+    int failures = 0;
+
+    /**
+     * @brief Records a failed check.
+     * @param check Name of the check.
+     * @param round Random instance where it failed.
+     * @param what Description of the mismatch.
+     */
+    void fail(const char* check, int round, const std::string& what) {
+        std::cerr << check << " (round " << round << "): " << what << "\n";
+        ++failures;
+    }
+
+    /**
+     * @brief Compares two results field by field.
+     *
+     * @param expected Reference result.
+     * @param result Result under test.
+     * @return true if the selection, profit and weight are equal.
+     */
+    bool sameResult(const ILPResult& expected, const ILPResult& result) {
+        return expected.selectedPallets == result.selectedPallets && expected.totalProfit == result.totalProfit
+               && expected.totalWeight == result.totalWeight;
+    }
+
+    /**
+     * @brief Draws a random instance of one of several shapes.
+     *
+     * @param rng Random generator.
+     * @param n Number of pallets.
+     * @return Pallets with IDs 1..n.
+     */
+    std::vector<Pallet> randomInstance(std::mt19937& rng, int n) {
+        int shape = static_cast<int>(rng() % 5);
+        int maxWeight = 1 + static_cast<int>(rng() % 40);
+        std::vector<Pallet> pallets;
+        for (int i = 0; i < n; ++i) {
+            int weight = static_cast<int>(rng() % (maxWeight + 1));
+            int profit = 0;
+            switch (shape) {
+                case 0: profit = static_cast<int>(rng() % 50); break;        // sem correlação
+                case 1: profit = weight; break;                              // soma de subconjuntos
+                case 2: weight = 1 + static_cast<int>(rng() % 3);            // poucos valores distintos
+                        profit = 1 + static_cast<int>(rng() % 3); break;
+                case 3: weight = 10; profit = 10; break;                     // paletes idênticas
+                default: profit = weight + static_cast<int>(rng() % 5); break; // fortemente correlacionado
+            }
+            pallets.push_back(Pallet{i + 1, weight, profit});
+        }
+        return pallets;
+    }
+
+    /**
+     * @brief Sets the DP table budget (KNAPSACK_SPILL_BYTES) for the next solves.
+     * @param bytes Threshold in bytes, or nullptr to restore the default.
+     */
+    void setSpillBytes(const char* bytes) {
+        if (bytes) setenv("KNAPSACK_SPILL_BYTES", bytes, 1);
+        else unsetenv("KNAPSACK_SPILL_BYTES");
+    }
+
+    /**
+     * @brief Brute force, DP and B&B return the same selection.
+     *
+     * Brute force runs up to 20 pallets. A second family uses profits near
+     * the 32-bit limit and a huge capacity, so the key needs 128 bits and
+     * only the searches (not the DP) can solve it.
+     */
+    void checkExact() {
+        const char* name = "exact";
+        std::mt19937 rng(62);
+        for (int round = 0; round < 1500; ++round) {
+            int n = 1 + static_cast<int>(rng() % 48);
+            int capacity = static_cast<int>(rng() % 250);
+            std::vector<Pallet> pallets = randomInstance(rng, n);
+
+            ILPResult expected = solveDynamic(pallets, capacity);
+            if (!sameResult(expected, solveILP(pallets, capacity))) fail(name, round, "solveILP differs from solveDynamic");
+            if (n <= 20 && !sameResult(expected, solveBruteForce(pallets, capacity))) {
+                fail(name, round, "solveBruteForce differs from solveDynamic");
+            }
+        }
+
+        for (int round = 0; round < 40; ++round) {
+            int n = 17 + static_cast<int>(rng() % 4);
+            std::vector<Pallet> pallets;
+            for (int i = 0; i < n; ++i) {
+                int weight = 1 + static_cast<int>(rng() % 200000000);
+                int profit = round % 2 == 0 ? weight : 2000000000 + static_cast<int>(rng() % 3);
+                pallets.push_back(Pallet{i + 1, weight, profit});
+            }
+            int capacity = 500000000 + static_cast<int>(rng() % 500000000);
+            if (!sameResult(solveBruteForce(pallets, capacity), solveILP(pallets, capacity))) {
+                fail(name, round, "solveILP differs from solveBruteForce on a 128-bit key");
+            }
+        }
+    }
+
+    /**
+     * @brief solvePreprocessed() returns the selection of the solver it wraps.
+     *
+     * Also through the workspace overload, with one workspace reused by
+     * every round.
+     */
+    void checkPreprocess() {
+        const char* name = "preprocess";
+        std::mt19937 rng(72);
+        auto dynamic = [](const std::vector<Pallet>& pallets, int capacity) { return solveDynamic(pallets, capacity); };
+        auto ilp = [](const std::vector<Pallet>& pallets, int capacity) { return solveILP(pallets, capacity); };
+        auto dynamicIn = [](const std::vector<Pallet>& pallets, int capacity, SolverWorkspace& workspace,
+                            ILPResult& out) { solveDynamic(pallets, capacity, workspace, out); };
+
+        // Um só workspace para todas as rondas, como no programa
+        SolverWorkspace workspace;
+        ILPResult shared;
+
+        for (int round = 0; round < 1000; ++round) {
+            int n = 1 + static_cast<int>(rng() % 48);
+            int capacity = static_cast<int>(rng() % 250);
+            std::vector<Pallet> pallets = randomInstance(rng, n);
+            ILPResult expected = solveDynamic(pallets, capacity);
+
+            PreprocessReport report;
+            if (!sameResult(expected, solvePreprocessed(pallets, capacity, dynamic, report))) {
+                fail(name, round, "preprocessed solveDynamic differs from the raw solve");
+            }
+            if (!sameResult(expected, solvePreprocessed(pallets, capacity, ilp, report))) {
+                fail(name, round, "preprocessed solveILP differs from the raw solve");
+            }
+            solvePreprocessed(pallets, capacity, dynamicIn, workspace, report, shared);
+            if (!sameResult(expected, shared)) fail(name, round, "preprocessing on a shared workspace differs");
+        }
+    }
+
+    /**
+     * @brief The cache-blocked DP, in memory and spilled to disk, matches the full table.
+     *
+     * Lowering KNAPSACK_SPILL_BYTES below the table size selects the
+     * cache-blocked pass; lowering it to 0 also moves its decision bits to
+     * the scratch file.
+     */
+    void checkTiled() {
+        const char* name = "tiled";
+        std::mt19937 rng(67);
+        for (int round = 0; round < 200; ++round) {
+            int n = 1 + static_cast<int>(rng() % 40);
+            int capacity = static_cast<int>(rng() % 3000);
+            std::vector<Pallet> pallets = randomInstance(rng, n);
+            for (Pallet& p : pallets) p.weight *= 1 + static_cast<int>(rng() % 50);
+
+            setSpillBytes(nullptr);
+            ILPResult expected = solveDynamic(pallets, capacity);
+
+            // Tabela completa acima do limite, bits de decisão abaixo: DP por blocos em memória
+            long long table = (static_cast<long long>(n) + 1) * (capacity + 1) * 8;
+            setSpillBytes(std::to_string(table / 4).c_str());
+            ILPResult tiled = solveDynamic(pallets, capacity);
+            DpSweepReport sweep = lastDpSweepReport();
+            if (sweep.cellsTotal != 0 && sweep.cellsTotal != static_cast<long long>(n) * (capacity + 1)) {
+                fail(name, round, "the cache-blocked DP did not run");
+            }
+            if (!sameResult(expected, tiled)) fail(name, round, "cache-blocked DP differs from the full table");
+
+            setSpillBytes("0");
+            if (!sameResult(expected, solveDynamic(pallets, capacity))) {
+                fail(name, round, "spilled DP differs from the full table");
+            }
+        }
+        setSpillBytes(nullptr);
+    }
+
+    /**
+     * @brief Solutions stored in a disk-backed cache are found again after a reload.
+     */
+    void checkCache() {
+        const char* name = "cache";
+        const std::string path = "solver_test.cache";
+        std::remove(path.c_str());
+
+        std::mt19937 rng(51);
+        std::vector<std::vector<Pallet>> instances;
+        std::vector<int> capacities;
+        std::vector<ILPResult> results;
+        std::unordered_set<CacheKey, CacheKeyHash> keys; // instâncias repetidas partilham uma entrada
+        {
+            SolutionCache cache(256, path);
+            for (int round = 0; round < 50; ++round) {
+                instances.push_back(randomInstance(rng, 1 + static_cast<int>(rng() % 30)));
+                capacities.push_back(static_cast<int>(rng() % 200));
+                results.push_back(solveDynamic(instances.back(), capacities.back()));
+                CacheKey key = SolutionCache::makeKey(instances.back(), capacities.back(), 2);
+                cache.store(key, results.back(), instances.back());
+                keys.insert(key);
+            }
+        }
+
+        // Outra instância lê o ficheiro escrito pela primeira
+        SolutionCache reloaded(256, path);
+        if (reloaded.size() != keys.size()) fail(name, 0, "reload lost entries");
+        for (size_t i = 0; i < instances.size(); ++i) {
+            ILPResult cached;
+            int round = static_cast<int>(i);
+            if (!reloaded.lookup(SolutionCache::makeKey(instances[i], capacities[i], 2), cached)) {
+                fail(name, round, "stored solution not found after reload");
+            } else if (!sameResult(results[i], cached)) {
+                fail(name, round, "reloaded solution differs from the stored one");
+            }
+            if (reloaded.lookup(SolutionCache::makeKey(instances[i], capacities[i], 4), cached)) {
+                fail(name, round, "hit for another solver");
+            }
+
+            ILPResult similar;
+            if (!reloaded.findSimilar(instances[i], capacities[i], 1.0, similar)) {
+                fail(name, round, "findSimilar misses the stored instance");
+            }
+        }
+        std::remove(path.c_str());
+    }
+
+    /**
+     * @brief A warm start leaves the B&B result unchanged and visits fewer nodes.
+     *
+     * Each instance (17 to 64 pallets, above the enumeration) is warm-started
+     * from the solution of a similar instance: the same pallets with a few
+     * removed, which the repair step completes greedily.
+     */
+    void checkWarmStart() {
+        const char* name = "warm_start";
+        std::mt19937 rng(52);
+        long long coldNodes = 0, warmNodes = 0; // totais de todas as instâncias
+        for (int round = 0; round < 300; ++round) {
+            int n = 17 + static_cast<int>(rng() % 48);
+            int capacity = 50 + static_cast<int>(rng() % 200);
+            std::vector<Pallet> pallets = randomInstance(rng, n);
+
+            ILPResult cold = solveILP(pallets, capacity);
+            long long coldCount = lastSearchNodes();
+
+            std::vector<Pallet> similar;
+            for (const Pallet& p : pallets) {
+                if (rng() % 8 != 0) similar.push_back(p);
+            }
+            ILPResult previous = solveILP(similar, capacity);
+
+            ILPResult warm = solveILP(pallets, capacity, previous.selectedPallets);
+            long long warmCount = lastSearchNodes();
+            if (!sameResult(cold, warm)) fail(name, round, "warm start changes the result");
+            if (warmCount > coldCount) fail(name, round, "warm start visits more nodes");
+            coldNodes += coldCount;
+            warmNodes += warmCount;
+        }
+        if (warmNodes >= coldNodes) fail(name, 0, "warm start never saves nodes");
+        std::cout << name << ": " << coldNodes << " nodes cold, " << warmNodes << " warm\n";
+    }
+
+    /**
+     * @brief The B&B stays polynomial on mid-size instances full of ties.
+     *
+     * Without the twin rule, n identical pallets have C(n, k) equally good
+     * loads of k pallets; without the equal-profit pruning every load that
+     * reaches the optimum with too many pallets is explored. The bounds are
+     * at least ten times the node counts measured with both in place.
+     */
+    void checkPruning() {
+        const char* name = "pruning";
+        std::mt19937 rng(75);
+        for (int n = 17; n <= 64; ++n) {
+            std::vector<Pallet> pallets;
+            for (int i = 0; i < n; ++i) pallets.push_back(Pallet{i + 1, 10, 10});
+            ILPResult result = solveILP(pallets, 165);
+            if (!sameResult(solveDynamic(pallets, 165), result)) fail(name, n, "identical pallets: wrong selection");
+            if (lastSearchNodes() > 100LL * n) fail(name, n, "identical pallets: too many nodes");
+        }
+
+        // Como o dataset 05: lucro igual ao peso, metade do peso total cabe
+        for (int round = 0; round < 50; ++round) {
+            std::vector<Pallet> pallets;
+            long long total = 0;
+            for (int i = 0; i < 30; ++i) {
+                int weight = 1 + static_cast<int>(rng() % 10);
+                pallets.push_back(Pallet{i + 1, weight, weight});
+                total += weight;
+            }
+            int capacity = static_cast<int>(total / 2);
+            ILPResult result = solveILP(pallets, capacity);
+            if (!sameResult(solveDynamic(pallets, capacity), result)) fail(name, round, "subset sum: wrong selection");
+            if (lastSearchNodes() > 50000) fail(name, round, "subset sum: too many nodes");
+        }
+    }
+
+    struct Check {
+        const char* name;
+        void (*run)();
+    };
+
+    const Check checks[] = {
+        {"exact", checkExact},
+        {"preprocess", checkPreprocess},
+        {"tiled", checkTiled},
+        {"cache", checkCache},
+        {"warm_start", checkWarmStart},
+        {"pruning", checkPruning},
+    };
+}
+
+int main(int argc, char** argv) {
+    bool ran = false;
+    for (const Check& check : checks) {
+        if (argc > 1 && std::strcmp(argv[1], check.name) != 0) continue;
+        check.run();
+        ran = true;
+    }
+    if (!ran) {
+        std::cerr << "Unknown check: " << argv[1] << "\n";
+        return 2;
+    }
+    if (failures > 0) std::cerr << failures << " mismatches\n";
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,172 @@
+/**
+ * @file workspace.h
+ * @brief Buffers reused by the solvers across solves.
+ *
+ * Every solve used to allocate its DP table, sorted copies and selection
+ * vectors from scratch. A SolverWorkspace owns those buffers instead: they
+ * only grow, so once a workspace has seen an instance as large as the
+ * current one, a solve through it performs no heap allocation (the result
+ * is also written into a caller-owned ILPResult). A workspace is not
+ * thread-safe; give each thread its own.
+ *
+ * @author Luís Martins e João Taveira
+ * @date 2025-05-20
+ */
+
+#ifndef WORKSPACE_H
+#define WORKSPACE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "Pallet.h"
+#include "algorithms.h"
+#include "dp_storage.h"
+
+/**
+ * @brief Non-owning view of a row-major table inside a workspace block.
+ *
+ * Rows start on 64-byte boundaries, as in DpMatrix. Cells are not cleared
+ * between solves.
+ *
+ * @tparam T Trivially copyable cell type.
+ */
+template <typename T>
+class DpRows {
+public:
+    DpRows(T* base, size_t stride) : base(base), stride(stride) {}
+
+    T* row(size_t i) const { return base + i * stride; }
+    T& operator()(size_t i, size_t j) const { return row(i)[j]; }
+
+private:
+    T* base;
+    size_t stride;
+};
+
+/**
+ * @brief One bit per pallet (input order), as kept by the search trails.
+ */
+struct TrailBits {
+    uint64_t* words;
+    size_t count; // número de palavras
+
+    void set(int i) { words[i / 64] |= uint64_t(1) << (i % 64); }
+    void reset(int i) { words[i / 64] &= ~(uint64_t(1) << (i % 64)); }
+    bool test(int i) const { return (words[i / 64] >> (i % 64)) & 1; }
+
+    /**
+     * @brief Copies another selection of the same size (an incumbent snapshot).
+     * @param other Selection to copy.
+     */
+    void assign(const TrailBits& other) { std::copy(other.words, other.words + count, words); }
+};
+
+/**
+ * @brief Monotonic arena for the decision trails of one search.
+ *
+ * A solve reserves the words it needs with begin(), carves its trails out
+ * of them with take() and drops them all at once with release(). The storage
+ * only grows, so after the first solve of a given size no allocation
+ * happens.
+ */
+class TrailArena {
+public:
+    /**
+     * @brief Releases every trail and makes room for the next search.
+     * @param words Total words the search will take().
+     */
+    void begin(size_t words) {
+        if (storage.size() < words) storage.resize(words);
+        used = 0;
+    }
+
+    /**
+     * @brief Takes a zeroed selection for pallets 0..pallets-1.
+     *
+     * @param pallets Number of pallets.
+     * @return Selection backed by the arena, valid until the next begin().
+     */
+    TrailBits take(size_t pallets) {
+        size_t count = wordsFor(pallets);
+        uint64_t* words = storage.data() + used;
+        used += count;
+        std::fill(words, words + count, uint64_t(0));
+        return TrailBits{words, count};
+    }
+
+    /**
+     * @brief Drops every trail at once, at the end of a search.
+     */
+    void release() { used = 0; }
+
+    /**
+     * @brief Words used by one selection.
+     * @param pallets Number of pallets.
+     * @return Words per selection (at least one).
+     */
+    static size_t wordsFor(size_t pallets) { return pallets / 64 + 1; }
+
+private:
+    std::vector<uint64_t> storage;
+    size_t used = 0;
+};
+
+/**
+ * @brief Growable buffers shared by KBruteForce, KDynamic, KProxy, solveILP and solvePreprocessed.
+ */
+class SolverWorkspace {
+public:
+    /**
+     * @brief Returns a rows x cols table on the workspace's aligned block.
+     *
+     * The block is reallocated (at least doubling) only when it is too small.
+     * The table is valid until the next call.
+     *
+     * @tparam T Trivially copyable cell type.
+     * @param rows Number of rows.
+     * @param cols Number of cells per row.
+     * @return View of the table, with unspecified cell values.
+     */
+    template <typename T>
+    DpRows<T> table(size_t rows, size_t cols) {
+        static_assert(std::is_trivially_copyable<T>::value, "DP cells are copied as raw memory");
+        static_assert(64 % sizeof(T) == 0, "rows are padded to whole cache lines");
+
+        size_t rowBytes = (cols * sizeof(T) + 63) / 64 * 64;
+        size_t bytes = rows * rowBytes;
+        if (bytes > block.size()) block = AlignedBlock(std::max(bytes, 2 * block.size()));
+        return DpRows<T>(static_cast<T*>(block.data()), rowBytes / sizeof(T));
+    }
+
+    /**
+     * @brief Memory of the last table handed out, for reports.
+     *
+     * Same cost as AlignedBlock::report().
+     *
+     * @param bytes Bytes of the block the table occupies.
+     * @return Report of those bytes.
+     */
+    DpMemoryReport tableReport(size_t bytes) const { return block.report(bytes); }
+
+    std::vector<Pallet> sorted;          // cópia ordenada das paletes (solveILP)
+    std::vector<int> order;              // índice original de cada palete ordenada (KProxy, solveILP)
+    std::vector<long long> prefWeight;   // somas prefixas do limite LP
+    std::vector<long long> prefProfit;
+    std::vector<long long> suffixMax;    // maior lucro de cada sufixo (limite de paletes do B&B)
+    TrailArena trail;                    // seleção atual e incumbente da força bruta e do B&B
+    std::vector<int> best;               // melhor seleção / reconstrução da DP
+    std::vector<int> ids;                // IDs auxiliares (KProxy, warm start)
+    std::vector<int> twins;              // palete idêntica anterior de cada palete ordenada (B&B), -1 se não há
+    std::vector<int> tail;               // paletes finais do B&B resolvidas pela DP
+    std::vector<char> flags;             // marcas por palete ordenada (warm start)
+    ILPResult result;                    // resultado dos wrappers que imprimem
+    ILPResult partial;                   // resultado na instância reduzida (solvePreprocessed)
+
+private:
+    AlignedBlock block;
+};
+
+#endif